@@ -19,6 +19,8 @@ class ModelManager: NSObject, ObservableObject {
     @Published var computeUnits: MLComputeUnits = .all
 
     private var pipeline: TTSPipeline?
+    /// Acoustic models loaded once; language switches only build a new front end
+    private var registry: TTSModelRegistry?
     private let modelURL = "https://firebasestorage.googleapis.com/v0/b/my-project-1494707780868.firebasestorage.app/o/converted.zip?alt=media&token=c27a1359-37c6-4b26-bd7d-8471d409a841"
     private let g2pURL = "https://firebasestorage.googleapis.com/v0/b/my-project-1494707780868.firebasestorage.app/o/v6%2Fg2p.zip?alt=media&token=c42ca3e3-c743-40a0-9f72-9afa5e8007f9"
     private let posModelURL = "https://firebasestorage.googleapis.com/v0/b/my-project-1494707780868.firebasestorage.app/o/quantized-bert-pos-tag.zip?alt=media&token=cd8b9030-8abd-4385-9fb9-9ec27ae5cad7"
@@ -156,26 +158,28 @@ class ModelManager: NSObject, ObservableObject {
     
     
     func initializePipeline() throws {
-        // Initialize real pipeline with downloaded models, vocab, POS models, and espeak data
-        // Files are extracted to root EspeakData directory
-        let espeakPath = espeakDataDirectory.path
+        // Initialize real pipeline with downloaded models, vocab and POS models
         let configuration = MLModelConfiguration()
         configuration.computeUnits = computeUnits
-        pipeline = try TTSPipeline(modelPath: modelsDirectory, vocabURL: vocabDirectory, postaggerModelURL: posModelsDirectory, language: .french, espeakDataPath: espeakPath, configuration: configuration)
-        pipeline?.performanceMonitoringEnabled = true  // Enable performance monitoring
+        registry = TTSModelRegistry(modelPath: modelsDirectory, vocabURL: vocabDirectory, postaggerModelURL: posModelsDirectory, configuration: configuration)
+        try reinitializePipeline(for: .englishUS)
         isModelReady = true
     }
     
-    /// Переинициализация pipeline с новым языком (при смене голоса/языка)
+    /// Переключение pipeline на другой язык (при смене голоса/языка).
+    /// Модели не перезагружаются: реестр создаёт только G2P и словарь нового языка.
     func reinitializePipeline(for language: Language) throws {
-        pipeline = nil  // Очищаем старый pipeline
-        // Files are extracted to root EspeakData directory
-        let espeakPath = espeakDataDirectory.path
-        let configuration = MLModelConfiguration()
-        configuration.computeUnits = computeUnits
-        pipeline = try TTSPipeline(modelPath: modelsDirectory, vocabURL: vocabDirectory, postaggerModelURL: posModelsDirectory, language: language, espeakDataPath: espeakPath, configuration: configuration)
-        pipeline?.performanceMonitoringEnabled = true
-        print("🔄 Pipeline reinitialized for language: \(language.rawValue)")
+        if registry == nil {
+            let configuration = MLModelConfiguration()
+            configuration.computeUnits = computeUnits
+            registry = TTSModelRegistry(modelPath: modelsDirectory, vocabURL: vocabDirectory, postaggerModelURL: posModelsDirectory, configuration: configuration)
+        }
+        guard let registry = registry else { return }
+        pipeline = try registry.pipeline(for: language)
+        pipeline?.performanceMonitoringEnabled = true  // Enable performance monitoring
+        // Держим в памяти только текущий язык, модели остаются загруженными
+        registry.removePipelines(except: language)
+        print("🔄 Pipeline switched to language: \(language.rawValue) in \(String(format: "%.0f", registry.statistics().lastPipelineSeconds * 1000)) ms")
     }
 
     /// Изменить computeUnits и переинициализировать pipeline
@@ -187,6 +191,9 @@ class ModelManager: NSObject, ObservableObject {
         }
 
         computeUnits = newComputeUnits
+        // Другие compute units требуют новой загрузки моделей
+        pipeline = nil
+        registry = nil
         try reinitializePipeline(for: currentLanguage)
         print("🔄 Pipeline reinitialized with computeUnits: \(newComputeUnits)")
     }
@@ -0,0 +1,182 @@
+import Foundation
+
+// MARK: - Audio Sink
+
+/// Destination for synthesized samples (mono float32 at the model sample rate).
+///
+/// The vocoder hands each chunk over as a buffer that is only valid for the
+/// duration of the call: it points straight into the iSTFT output, so sinks
+/// copy what they need into their own storage and nothing else is allocated
+/// on the way.
+public protocol AudioSink: AnyObject {
+    /// Consumes the next chunk of samples
+    func write(_ samples: UnsafeBufferPointer<Float>) throws
+}
+
+// MARK: - Contiguous Buffer
+
+/// Writes samples into a caller-owned buffer, e.g. an `AVAudioPCMBuffer` channel.
+///
+/// The buffer must outlive the sink. Writing past its end throws and leaves
+/// the already written samples intact.
+public final class ContiguousAudioSink: AudioSink {
+    private let buffer: UnsafeMutableBufferPointer<Float>
+    public private(set) var count = 0
+
+    public init(buffer: UnsafeMutableBufferPointer<Float>) {
+        self.buffer = buffer
+    }
+
+    public var remainingCapacity: Int {
+        return buffer.count - count
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        guard samples.count <= remainingCapacity else {
+            throw TTSError.invalidInput("Audio buffer full: \(samples.count) samples, \(remainingCapacity) left")
+        }
+        guard let source = samples.baseAddress, let destination = buffer.baseAddress else { return }
+        (destination + count).update(from: source, count: samples.count)
+        count += samples.count
+    }
+}
+
+// MARK: - Array
+
+/// Collects samples into a growing `[Float]`, used by the array-returning APIs
+public final class ArrayAudioSink: AudioSink {
+    public private(set) var samples: [Float] = []
+
+    public init(reservingCapacity capacity: Int = 0) {
+        samples.reserveCapacity(capacity)
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        self.samples.append(contentsOf: samples)
+    }
+}
+
+// MARK: - Ring Buffer
+
+/// Fixed-size ring buffer between the synthesis thread and a playback callback.
+///
+/// One producer writes, one consumer reads. When the producer gets ahead by
+/// more than `capacity` samples, the oldest samples are dropped and counted in
+/// `overrunSamples` rather than blocking synthesis.
+public final class RingBufferAudioSink: AudioSink, @unchecked Sendable {
+    private let storage: UnsafeMutableBufferPointer<Float>
+    private let lock = NSLock()
+    private var readIndex = 0
+    private var available = 0
+    private var overrun = 0
+
+    public init(capacity: Int) {
+        self.storage = .allocate(capacity: max(capacity, 1))
+        storage.initialize(repeating: 0)
+    }
+
+    deinit {
+        storage.deallocate()
+    }
+
+    public var capacity: Int {
+        return storage.count
+    }
+
+    /// Samples written but not read yet
+    public var availableSamples: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return available
+    }
+
+    /// Samples dropped because the reader fell behind
+    public var overrunSamples: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return overrun
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        lock.lock()
+        defer { lock.unlock() }
+
+        // Only the newest `capacity` samples of the chunk can survive
+        var source = samples[...]
+        if source.count > storage.count {
+            overrun += source.count - storage.count
+            source = source.suffix(storage.count)
+        }
+        let overflow = available + source.count - storage.count
+        if overflow > 0 {
+            readIndex = (readIndex + overflow) % storage.count
+            available -= overflow
+            overrun += overflow
+        }
+
+        var writeIndex = (readIndex + available) % storage.count
+        let written = source.count
+        while !source.isEmpty {
+            let run = min(source.count, storage.count - writeIndex)
+            UnsafeMutableBufferPointer(rebasing: storage[writeIndex..<(writeIndex + run)])
+                .update(fromContentsOf: UnsafeBufferPointer(rebasing: source.prefix(run)))
+            source = source.dropFirst(run)
+            writeIndex = (writeIndex + run) % storage.count
+        }
+        available += written
+    }
+
+    /// Copies up to `destination.count` samples out of the ring
+    /// - Returns: Number of samples read
+    @discardableResult
+    public func read(into destination: UnsafeMutableBufferPointer<Float>) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+
+        let total = min(destination.count, available)
+        var copied = 0
+        while copied < total {
+            let run = min(total - copied, storage.count - readIndex)
+            UnsafeMutableBufferPointer(rebasing: destination[copied..<(copied + run)])
+                .update(fromContentsOf: UnsafeBufferPointer(rebasing: storage[readIndex..<(readIndex + run)]))
+            copied += run
+            readIndex = (readIndex + run) % storage.count
+        }
+        available -= total
+        return total
+    }
+}
+
+// MARK: - File
+
+/// Appends raw little-endian float32 samples to a file as they are produced (no header)
+public final class FileAudioSink: AudioSink {
+    private let handle: FileHandle
+    public private(set) var count = 0
+
+    /// Creates (or truncates) the file at `url`
+    public init(url: URL) throws {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw TTSError.invalidInput("Cannot create audio file at \(url.path)")
+        }
+        self.handle = try FileHandle(forWritingTo: url)
+    }
+
+    deinit {
+        try? handle.close()
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        guard let base = samples.baseAddress, !samples.isEmpty else { return }
+        // Apple platforms are little-endian, the samples are written as they are in memory
+        let data = Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: base), count: samples.count * MemoryLayout<Float>.size, deallocator: .none)
+        try handle.write(contentsOf: data)
+        count += samples.count
+    }
+
+    /// Flushes and closes the file; further writes fail
+    public func close() throws {
+        try handle.synchronize()
+        try handle.close()
+    }
+}
@@ -0,0 +1,261 @@
+import Foundation
+
+/// Predicted cost of synthesizing one or more segments
+public struct SynthesisCost: Sendable {
+    /// Model tokens including the two pads per segment
+    public let tokens: Int
+    /// Predicted (or, once `framesMeasured`, actual) duration frames
+    public let frames: Int
+    /// `true` after ProsodyPredictor durations replaced the per-token estimate
+    public let framesMeasured: Bool
+    /// Predicted seconds per `PerformanceMonitor.Module` stage
+    public let stageSeconds: [String: TimeInterval]
+    /// Largest set of float32 tensors alive at once in the pipeline
+    public let peakTensorBytes: Int
+
+    /// Audio samples at the model rate
+    public var samples: Int {
+        return frames * SynthesisCostModel.samplesPerFrame
+    }
+
+    public var seconds: TimeInterval {
+        return stageSeconds.values.reduce(0, +)
+    }
+
+    /// Cost of running `self` and `other` back to back: times add up, peak memory does not
+    public func combined(with other: SynthesisCost) -> SynthesisCost {
+        return SynthesisCost(
+            tokens: tokens + other.tokens,
+            frames: frames + other.frames,
+            framesMeasured: framesMeasured && other.framesMeasured,
+            stageSeconds: stageSeconds.merging(other.stageSeconds, uniquingKeysWith: +),
+            peakTensorBytes: max(peakTensorBytes, other.peakTensorBytes)
+        )
+    }
+
+    static let zero = SynthesisCost(tokens: 0, frames: 0, framesMeasured: true, stageSeconds: [:], peakTensorBytes: 0)
+}
+
+/// Stage timings and sizes of one `TTSModel.infer` call, fed back into `SynthesisCostModel`
+final class InferenceTrace {
+    let tokens: Int
+    let speed: Float
+    /// Total of `pred_dur`, set once ProsodyPredictor returns
+    var frames: Int?
+    var stageSeconds: [String: TimeInterval] = [:]
+    /// Bytes written by tensor copies and gathers per stage
+    var bytesMoved: [String: Int] = [:]
+    /// Inference stops before alignment when durations exceed this many frames
+    let frameLimit: Int?
+    /// Length of the `input_ids` array when padded to a `LengthBuckets` size
+    var paddedTokens: Int?
+    /// Alignment columns when the frames were padded to a `LengthBuckets` size
+    var paddedFrames: Int?
+
+    init(tokens: Int, speed: Float = 1, frameLimit: Int? = nil) {
+        self.tokens = tokens
+        self.speed = speed
+        self.frameLimit = frameLimit
+    }
+}
+
+/// Calibrated estimator of per-stage latency and peak tensor memory.
+///
+/// The text stages (BERT, encoders, duration and prosody predictors) scale
+/// with the token count; alignment, F0 prediction, the decoder and the
+/// vocoder scale with the duration frames, whose vocoder tensors are
+/// `frames × 600` samples long (two F0 steps per frame, upsampled ×300).
+/// Before inference the frames are predicted from the tokens and speed;
+/// `refined(_:frames:)` swaps in the real total once `pred_dur` is known.
+///
+/// Every stage time is a linear fit `a + b·x` over recent measurements, with
+/// exponential forgetting so the model follows thermal state and compute
+/// unit changes. Until a stage has enough measurements the starting values
+/// below are used; they are rough and only meant to rank requests.
+public final class SynthesisCostModel: @unchecked Sendable {
+
+    /// Model samples per duration frame
+    public static let samplesPerFrame = 600
+
+    private enum Driver {
+        case tokens
+        case frames
+    }
+
+    /// Stages, what drives their cost and starting values (seconds, seconds per unit)
+    private static let stages: [(module: String, driver: Driver, intercept: Double, slope: Double)] = [
+        (PerformanceMonitor.Module.bert, .tokens, 0.010, 0.000_05),
+        (PerformanceMonitor.Module.bertEncoder, .tokens, 0.001, 0.000_01),
+        (PerformanceMonitor.Module.durationEncoder, .tokens, 0.005, 0.000_05),
+        (PerformanceMonitor.Module.prosodyPredictor, .tokens, 0.005, 0.000_05),
+        (PerformanceMonitor.Module.textEncoder, .tokens, 0.003, 0.000_02),
+        (PerformanceMonitor.Module.alignment, .frames, 0.000_5, 0.000_002),
+        (PerformanceMonitor.Module.f0Predictor, .frames, 0.005, 0.000_02),
+        (PerformanceMonitor.Module.decoder, .frames, 0.010, 0.000_1),
+        (PerformanceMonitor.Module.generator, .frames, 0.020, 0.000_3),
+    ]
+
+    /// Stages with a latency prediction
+    static var stageCount: Int {
+        return stages.count
+    }
+
+    /// Channel counts of the float32 tensors used by `peakTensorBytes`
+    private enum Channels {
+        static let bertHidden = 768
+        static let hidden = 512
+        /// Hidden plus the 128-dim style vector
+        static let styled = 640
+        /// Sine harmonics, source and excitation per vocoder sample
+        static let vocoderPerSample = 11
+        /// STFT magnitude and phase bins per frame (hop 5, n_fft 20)
+        static let stftPerFrame = 2 * 22 * 120
+    }
+
+    /// Weight kept by old measurements on each new one
+    private static let forgetting = 0.98
+    /// Measurements before a fit replaces the starting values
+    private static let minimumSamples = 3.0
+
+    private struct LinearFit {
+        var weight = 0.0
+        var sumX = 0.0
+        var sumY = 0.0
+        var sumXX = 0.0
+        var sumXY = 0.0
+
+        mutating func add(x: Double, y: Double) {
+            weight = weight * SynthesisCostModel.forgetting + 1
+            sumX = sumX * SynthesisCostModel.forgetting + x
+            sumY = sumY * SynthesisCostModel.forgetting + y
+            sumXX = sumXX * SynthesisCostModel.forgetting + x * x
+            sumXY = sumXY * SynthesisCostModel.forgetting + x * y
+        }
+
+        func predict(_ x: Double, intercept: Double, slope: Double) -> Double {
+            guard weight >= SynthesisCostModel.minimumSamples else {
+                return intercept + slope * x
+            }
+            let meanX = sumX / weight
+            let meanY = sumY / weight
+            let variance = sumXX / weight - meanX * meanX
+            // Requests of one size: scale the prior through the observed mean
+            guard variance > 1e-9 * max(meanX * meanX, 1) else {
+                let prior = intercept + slope * meanX
+                return prior > 0 ? meanY * (intercept + slope * x) / prior : meanY
+            }
+            let fittedSlope = max((sumXY / weight - meanX * meanY) / variance, 0)
+            let fittedIntercept = max(meanY - fittedSlope * meanX, 0)
+            return fittedIntercept + fittedSlope * x
+        }
+    }
+
+    private let lock = NSLock()
+    private var fits: [String: LinearFit] = [:]
+    /// Running frames per token at speed 1
+    private var frameWeight = 0.0
+    private var frameSum = 0.0
+    private var tokenSum = 0.0
+    /// Speech runs at roughly 13 phonemes per second, 40 frames per second
+    private static let defaultFramesPerToken = 3.0
+
+    public init() {}
+
+    /// Predicted frames per token at speed 1
+    public var framesPerToken: Double {
+        lock.lock()
+        defer { lock.unlock() }
+        return frameWeight >= SynthesisCostModel.minimumSamples && tokenSum > 0 ? frameSum / tokenSum : SynthesisCostModel.defaultFramesPerToken
+    }
+
+    /// Cost before inference; frames are predicted from the tokens and `speed`
+    public func estimate(tokens: Int, speed: Float = 1) -> SynthesisCost {
+        let frames = Int((Double(tokens) * framesPerToken / Double(max(speed, 0.1))).rounded())
+        return cost(tokens: tokens, frames: frames, measured: false)
+    }
+
+    /// Cost of all segments of a prepared request
+    public func estimate(_ utterance: PreparedUtterance) -> SynthesisCost {
+        return utterance.segments.reduce(SynthesisCost.zero) { total, segment in
+            total.combined(with: estimate(tokens: segment.unicodeScalars.count + 2, speed: utterance.options.speed))
+        }
+    }
+
+    /// Re-estimates with the frame total from ProsodyPredictor's `pred_dur`
+    public func refined(_ estimate: SynthesisCost, frames: Int) -> SynthesisCost {
+        return cost(tokens: estimate.tokens, frames: frames, measured: true)
+    }
+
+    /// Most tokens per segment whose predicted peak memory fits `peakTensorBytes`, 0 if none
+    public func maxTokens(peakTensorBytes budget: Int, speed: Float = 1) -> Int {
+        var low = 0
+        var high = PhonemeSegmenter.defaultMaxPhonemes + 2
+        while low < high {
+            let middle = (low + high + 1) / 2
+            if estimate(tokens: middle, speed: speed).peakTensorBytes <= budget {
+                low = middle
+            } else {
+                high = middle - 1
+            }
+        }
+        return low
+    }
+
+    /// Most frames a segment of `tokens` can have within `peakTensorBytes`
+    public func maxFrames(tokens: Int, peakTensorBytes budget: Int) -> Int {
+        var low = 0
+        var high = max(budget / MemoryLayout<Float>.size, 1)
+        while low < high {
+            let middle = low + (high - low + 1) / 2
+            if SynthesisCostModel.peakTensorBytes(tokens: tokens, frames: middle) <= budget {
+                low = middle
+            } else {
+                high = middle - 1
+            }
+        }
+        return low
+    }
+
+    /// Adds the measurements of a finished inference
+    func record(_ trace: InferenceTrace) {
+        guard let frames = trace.frames, trace.tokens > 0 else { return }
+        lock.lock()
+        defer { lock.unlock() }
+        for stage in SynthesisCostModel.stages {
+            guard let seconds = trace.stageSeconds[stage.module] else { continue }
+            let x = stage.driver == .tokens ? trace.tokens : frames
+            fits[stage.module, default: LinearFit()].add(x: Double(x), y: seconds)
+        }
+        frameWeight = frameWeight * SynthesisCostModel.forgetting + 1
+        frameSum = frameSum * SynthesisCostModel.forgetting + Double(frames) * Double(max(trace.speed, 0.1))
+        tokenSum = tokenSum * SynthesisCostModel.forgetting + Double(trace.tokens)
+    }
+
+    private func cost(tokens: Int, frames: Int, measured: Bool) -> SynthesisCost {
+        lock.lock()
+        var stageSeconds: [String: TimeInterval] = [:]
+        for stage in SynthesisCostModel.stages {
+            let x = Double(stage.driver == .tokens ? tokens : frames)
+            stageSeconds[stage.module] = (fits[stage.module] ?? LinearFit()).predict(x, intercept: stage.intercept, slope: stage.slope)
+        }
+        lock.unlock()
+        return SynthesisCost(
+            tokens: tokens,
+            frames: frames,
+            framesMeasured: measured,
+            stageSeconds: stageSeconds,
+            peakTensorBytes: SynthesisCostModel.peakTensorBytes(tokens: tokens, frames: frames)
+        )
+    }
+
+    /// Largest of the text, alignment and vocoder working sets, float32 tensors only
+    static func peakTensorBytes(tokens: Int, frames: Int) -> Int {
+        // BERT hidden state, d_en, duration encoder output
+        let text = tokens * (Channels.bertHidden + Channels.hidden + Channels.styled)
+        // en and asr, plus the token-rate d and t_en they are gathered from
+        let alignment = frames * (Channels.styled + Channels.hidden) + tokens * (Channels.styled + Channels.hidden)
+        // Decoder output at two steps per frame, harmonic source and STFT of frames × 600 samples
+        let vocoder = frames * (2 * Channels.hidden + samplesPerFrame * Channels.vocoderPerSample + Channels.stftPerFrame)
+        return max(text, alignment, vocoder) * MemoryLayout<Float>.size
+    }
+}
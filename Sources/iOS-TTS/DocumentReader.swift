@@ -0,0 +1,213 @@
+import Foundation
+
+// MARK: - Mapped Text Lines
+
+/// Lines of a UTF-8 text file read through a memory mapping.
+///
+/// The file is mapped, not loaded: pages are faulted in as the iterator walks
+/// forward, and only the current line is ever decoded into a `String`. Lines
+/// longer than `maxLineBytes` (a whole book without newlines) are cut at the
+/// last space inside the window, so no single element grows with the file.
+public struct MappedTextLines: AsyncSequence, Sendable {
+    public typealias Element = String
+
+    /// Upper bound for one decoded line in UTF-8 bytes
+    public static let defaultMaxLineBytes = 16 * 1024
+
+    private let data: Data
+    private let maxLineBytes: Int
+
+    public init(contentsOf url: URL, maxLineBytes: Int = defaultMaxLineBytes) throws {
+        self.data = try Data(contentsOf: url, options: .alwaysMapped)
+        self.maxLineBytes = max(maxLineBytes, 4)
+    }
+
+    /// Total size of the mapped file in bytes
+    public var byteCount: Int {
+        return data.count
+    }
+
+    public func makeAsyncIterator() -> Iterator {
+        return Iterator(data: data, maxLineBytes: maxLineBytes)
+    }
+
+    public struct Iterator: AsyncIteratorProtocol {
+        private let data: Data
+        private let maxLineBytes: Int
+        private var offset = 0
+
+        fileprivate init(data: Data, maxLineBytes: Int) {
+            self.data = data
+            self.maxLineBytes = maxLineBytes
+        }
+
+        public mutating func next() async -> String? {
+            return nextLine()
+        }
+
+        /// Synchronous body of `next()`, also used by tests
+        mutating func nextLine() -> String? {
+            guard offset < data.count else { return nil }
+            let start = offset
+            let maxLineBytes = maxLineBytes
+
+            let (line, resume) = data.withUnsafeBytes { raw -> (String, Int) in
+                let bytes = raw.bindMemory(to: UInt8.self)
+                let limit = min(bytes.count, start + maxLineBytes)
+
+                var end = start
+                while end < limit && bytes[end] != UInt8(ascii: "\n") {
+                    end += 1
+                }
+                var resume = end + 1
+                if end == limit && limit < bytes.count {
+                    // No newline inside the window: break at the last space, else at a scalar boundary
+                    var cut = end
+                    while cut > start && bytes[cut - 1] != UInt8(ascii: " ") {
+                        cut -= 1
+                    }
+                    if cut == start {
+                        cut = end
+                        while cut > start && bytes[cut] & 0xC0 == 0x80 {
+                            cut -= 1
+                        }
+                    }
+                    end = cut
+                    resume = cut
+                }
+
+                var contentEnd = end
+                if contentEnd > start && bytes[contentEnd - 1] == UInt8(ascii: "\r") {
+                    contentEnd -= 1
+                }
+                let line = String(decoding: UnsafeBufferPointer(rebasing: bytes[start..<contentEnd]), as: UTF8.self)
+                return (line, resume)
+            }
+
+            offset = resume
+            return line
+        }
+    }
+}
+
+// MARK: - Document Segmenter
+
+/// Turns a stream of lines into sentences with a bounded paragraph buffer.
+///
+/// Consecutive non-empty lines form a paragraph, a blank line ends it. Once the
+/// buffered paragraph exceeds `maxParagraphBytes`, every complete sentence is
+/// emitted and only the trailing (possibly unfinished) one is kept.
+struct DocumentSegmenter {
+    static let defaultMaxParagraphBytes = 4 * 1024
+
+    private let maxParagraphBytes: Int
+    private var paragraph = ""
+
+    init(maxParagraphBytes: Int = defaultMaxParagraphBytes) {
+        self.maxParagraphBytes = maxParagraphBytes
+    }
+
+    /// Adds a line and returns the sentences that are complete after it
+    mutating func append<Line: StringProtocol>(line: Line) -> [String] {
+        let trimmed = line.trimmingCharacters(in: .whitespaces)
+        guard !trimmed.isEmpty else {
+            return finish()
+        }
+        if !paragraph.isEmpty {
+            paragraph += " "
+        }
+        paragraph += trimmed
+        guard paragraph.utf8.count > maxParagraphBytes else {
+            return []
+        }
+
+        let sentences = SentenceSplitter.split(paragraph)
+        guard sentences.count > 1, let last = sentences.last else {
+            // A single sentence longer than the buffer is emitted as is
+            return finish()
+        }
+        let complete = sentences.dropLast().map { String($0) }
+        paragraph = String(last)
+        return complete
+    }
+
+    /// Flushes the buffered paragraph
+    mutating func finish() -> [String] {
+        defer { paragraph = "" }
+        return SentenceSplitter.split(paragraph).map { String($0) }
+    }
+}
+
+// MARK: - Phoneme Segmenter
+
+/// Packs sentence phoneme strings into model-sized segments.
+///
+/// Sentences are joined with a space while the segment stays within
+/// `maxPhonemes` scalars (the input ids add two pads on top). A sentence that
+/// alone exceeds the limit is cut after the last clause punctuation, else the
+/// last space, inside the window.
+struct PhonemeSegmenter {
+    /// 512-token context of the model minus the two pads
+    static let defaultMaxPhonemes = 510
+
+    private let maxPhonemes: Int
+    private var current: [Unicode.Scalar] = []
+
+    init(maxPhonemes: Int = defaultMaxPhonemes) {
+        self.maxPhonemes = max(maxPhonemes, 1)
+    }
+
+    /// Adds a sentence and returns the segments that are full after it
+    mutating func append(_ phonemes: String) -> [String] {
+        let scalars = Array(phonemes.unicodeScalars)
+        guard !scalars.isEmpty else { return [] }
+
+        var segments: [String] = []
+        let separator = current.isEmpty ? 0 : 1
+        if current.count + separator + scalars.count <= maxPhonemes {
+            if separator == 1 {
+                current.append(" ")
+            }
+            current.append(contentsOf: scalars)
+            return segments
+        }
+
+        if let segment = finish() {
+            segments.append(segment)
+        }
+        var rest = scalars[...]
+        while rest.count > maxPhonemes {
+            let cut = PhonemeSegmenter.cutIndex(in: rest, limit: maxPhonemes)
+            segments.append(PhonemeSegmenter.string(rest[..<cut]))
+            rest = rest[cut...].drop { $0 == " " }
+        }
+        current.append(contentsOf: rest)
+        return segments
+    }
+
+    /// Flushes the last segment
+    mutating func finish() -> String? {
+        defer { current.removeAll(keepingCapacity: true) }
+        let segment = PhonemeSegmenter.string(current[...])
+        return segment.isEmpty ? nil : segment
+    }
+
+    private static let clauseBreaks: Set<Unicode.Scalar> = [".", "!", "?", ",", ";", ":", "—", "…"]
+
+    private static func cutIndex(in scalars: ArraySlice<Unicode.Scalar>, limit: Int) -> Int {
+        let window = scalars.startIndex..<(scalars.startIndex + limit)
+        if let space = window.reversed().first(where: { scalars[$0] == " " && $0 > scalars.startIndex && clauseBreaks.contains(scalars[$0 - 1]) }) {
+            return space
+        }
+        if let space = window.reversed().first(where: { scalars[$0] == " " && $0 > scalars.startIndex }) {
+            return space
+        }
+        return window.upperBound
+    }
+
+    private static func string(_ scalars: ArraySlice<Unicode.Scalar>) -> String {
+        var view = String.UnicodeScalarView()
+        view.append(contentsOf: scalars)
+        return String(view).trimmingCharacters(in: .whitespaces)
+    }
+}
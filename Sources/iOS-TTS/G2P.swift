@@ -1,18 +1,20 @@
 import Foundation
 
 /// Токен с метаданными для G2P обработки (как в Python MToken)
-public class MToken {
-    let text: String
-    let tag: String  // POS tag
+///
+/// Значимый тип: внутри `G2PEn` токены хранятся в `TokenTable`, а не как граф объектов.
+public struct MToken: Sendable {
+    var text: String
+    var tag: String  // POS tag
     var whitespace: String  // Пробелы после токена
     var phonemes: String?  // Фонемы для токена
     var rating: Int? = nil  // Качество фонетизации (0-5)
-    let startTs: Double?  // Временная метка начала
-    let endTs: Double?    // Временная метка конца
+    var startTs: Double?  // Временная метка начала
+    var endTs: Double?    // Временная метка конца
     var underscore: Underscore  // Дополнительные метаданные (как _ в Python)
     
     /// Структура для дополнительных метаданных (как Python MToken.Underscore)
-    public class Underscore {
+    public struct Underscore: Sendable {
         var isHead: Bool = true
         var alias: String? = nil
         var stress: Double? = nil  // -2 to 2, может быть 0.5/-0.5
@@ -32,26 +34,73 @@ public class MToken {
         }
     }
     
-    public init(text: String, tag: String, whitespace: String = "", phonemes: String? = nil, startTs: Double? = nil, endTs: Double? = nil, underscore: Underscore? = nil) {
+    public init(text: String, tag: String, whitespace: String = "", phonemes: String? = nil, rating: Int? = nil, startTs: Double? = nil, endTs: Double? = nil, underscore: Underscore? = nil) {
         self.text = text
         self.tag = tag
         self.whitespace = whitespace
         self.phonemes = phonemes
+        self.rating = rating
         self.startTs = startTs
         self.endTs = endTs
         self.underscore = underscore ?? Underscore()
     }
 }
 
+/// Итоговый токен в результате G2P: текст и диапазон его фонем в `phonemeString`
+public struct G2PTokenSpan: Sendable, Equatable {
+    public let text: String
+    public let tag: String
+    public internal(set) var whitespace: String
+    /// Диапазон фонем токена в `phonemeString` в Unicode-скалярах (совпадает с позициями id токенизатора)
+    public internal(set) var phonemes: Range<Int>
+    /// Качество фонетизации (0-5), `nil` - фонемы не найдены
+    public let rating: Int?
+    
+    public init(text: String, tag: String, whitespace: String, phonemes: Range<Int>, rating: Int?) {
+        self.text = text
+        self.tag = tag
+        self.whitespace = whitespace
+        self.phonemes = phonemes
+        self.rating = rating
+    }
+}
+
 /// Результат G2P обработки
-public struct G2PResult {
+public struct G2PResult: Sendable {
     let phonemeString: String
-    let tokens: [MToken]
+    let tokens: [G2PTokenSpan]
     
-    public init(phonemeString: String, tokens: [MToken]) {
+    public init(phonemeString: String, tokens: [G2PTokenSpan]) {
         self.phonemeString = phonemeString
         self.tokens = tokens
     }
+    
+    /// Результат из токенов `MToken` - для внешних реализаций G2P.
+    ///
+    /// Диапазоны фонем идут подряд: фонемы токена, затем его `whitespace`,
+    /// как `phonemeString` собирается из токенов в Python. Токен без фонем
+    /// получает пустой диапазон и `rating == nil`. Для `tokens: []` выбирается
+    /// основной инициализатор.
+    @_disfavoredOverload
+    public init(phonemeString: String, tokens: [MToken]) {
+        let total = phonemeString.unicodeScalars.count
+        var offset = 0
+        var spans: [G2PTokenSpan] = []
+        spans.reserveCapacity(tokens.count)
+        for token in tokens {
+            let start = min(offset, total)
+            let end = min(start + (token.phonemes?.unicodeScalars.count ?? 0), total)
+            spans.append(G2PTokenSpan(
+                text: token.text,
+                tag: token.tag,
+                whitespace: token.whitespace,
+                phonemes: start..<end,
+                rating: token.phonemes == nil ? nil : token.rating ?? token.underscore.rating
+            ))
+            offset = end + token.whitespace.unicodeScalars.count
+        }
+        self.init(phonemeString: phonemeString, tokens: spans)
+    }
 }
 
 /// Протокол для реализации G2P (Grapheme-to-Phoneme) конвертации
@@ -2,11 +2,19 @@ import Foundation
 import SwiftPOSTagger
 
 /// G2P implementation for English using lexicon-based phonemization
-public class G2PEn: G2P {
+///
+/// Safe to share between threads: the lexicon and the word cache are thread-safe,
+/// token state is local to each `convert` call and the POS tagger is serialized.
+public final class G2PEn: G2P, @unchecked Sendable {
     private let isAmericanEnglish: Bool
     private let vocabURL: URL
-    private let postagger: SwiftPOSTagger
+    private let postagger: ResidentResource<SwiftPOSTagger>
+    private let postaggerLock = NSLock()
+    private var taggerCounters = TaggerStatistics()
+    private let statisticsLock = NSLock()
     private let lexicon: Lexicon
+    private let wordCache: G2PWordCache
+    private let skipsUnambiguousTagging: Bool
     private let unk: String = "❓"
 
     // MARK: - Initialization
@@ -16,12 +24,27 @@ public class G2PEn: G2P {
     ///   - british: false for American English, true for British English
     ///   - vocabURL: URL of folder containing vocab files (us_gold.json, us_silver.json, gb_gold.json, gb_silver.json)
     ///   - postaggerModelURL: URL of folder containing SwiftPOSTagger model (Model.mlmodelc, vocab.txt, outTokens.txt)
-    public init(british: Bool, vocabURL: URL, postaggerModelURL: URL) throws {
+    ///   - wordCacheCapacity: Number of (word, tag, context) results kept in the LRU cache, 0 disables it
+    ///   - skipsUnambiguousTagging: Tag sentences without POS-sensitive words with `RuleBasedTagger` instead of the model
+    ///   - residency: Manager that may load the POS tagger on first use and unload it; `nil` keeps it loaded
+    public init(british: Bool, vocabURL: URL, postaggerModelURL: URL, wordCacheCapacity: Int = 4096, skipsUnambiguousTagging: Bool = true, residency: ModelResidencyManager? = nil) throws {
         self.isAmericanEnglish = !british
         self.vocabURL = vocabURL
+        self.wordCache = G2PWordCache(capacity: wordCacheCapacity)
+        self.skipsUnambiguousTagging = skipsUnambiguousTagging
 
         // Initialize POS tagger
-        self.postagger = try SwiftPOSTagger(modelDirectoryURL: postaggerModelURL)
+        if let residency = residency {
+            let postagger = residency.register(name: "POSTagger", bytes: ModelResidencyManager.bundleBytes(at: postaggerModelURL)) {
+                try SwiftPOSTagger(modelDirectoryURL: postaggerModelURL)
+            }
+            if !residency.policy.loadOnFirstUse {
+                try postagger.prefetch()
+            }
+            self.postagger = postagger
+        } else {
+            self.postagger = ResidentResource(name: "POSTagger", resident: try SwiftPOSTagger(modelDirectoryURL: postaggerModelURL))
+        }
 
         // Initialize Lexicon
         self.lexicon = try Lexicon(british: british, vocabURL: vocabURL)
@@ -36,8 +59,14 @@ public class G2PEn: G2P {
         print("🔍 G2P.preprocess tokens: \(preprocessResult.tokens)")
         print("🔍 G2P.preprocess features: \(preprocessResult.features)")
         
-        // Токенизация и POS-теггинг
-        var tokens = try tokenize(text: preprocessResult.result, tokens: preprocessResult.tokens, features: preprocessResult.features)
+        let tagged = try tag(preprocessResult.result)
+        return convert(preprocessResult, tagged: tagged)
+    }
+    
+    /// Фонемизация уже размеченного теггером текста
+    private func convert(_ preprocessResult: PreprocessResult, tagged: [(String, String)]) -> G2PResult {
+        // Токенизация по результатам POS-теггинга
+        var tokens = makeTokens(from: tagged, features: preprocessResult.features)
         for (i, token) in tokens.enumerated() {
             print("🔍 Token[\(i)]: text='\(token.text)', tag='\(token.tag)', whitespace='\(token.whitespace)', phonemes='\(token.phonemes ?? "nil")', stress=\(token.underscore.stress?.description ?? "nil"), numFlags='\(token.underscore.numFlags)', rating=\(token.underscore.rating?.description ?? "nil"), isHead=\(token.underscore.isHead)")
         }
@@ -45,58 +74,234 @@ public class G2PEn: G2P {
         tokens = foldLeft(tokens: tokens)
         
         // retokenize - разбиение на подтокены
-        let words = G2PEn.retokenize(tokens: tokens)
+        var table = G2PEn.retokenize(tokens: tokens)
         
         // Процесс как в Python __call__ метода
         var context = TokenContext()
         
         // Обрабатываем в обратном порядке как в Python
-        for i in stride(from: words.count - 1, through: 0, by: -1) {
-            let word = words[i]
-            
-            if let singleToken = word as? MToken {
+        for word in table.words.reversed() {
+            switch word {
+            case .single(let index):
                 // Отдельный токен - обрабатываем через lexicon
-                if singleToken.phonemes == nil {
-                    let (phonemes, rating) = lexicon.processToken(singleToken, context: context)
-                    singleToken.phonemes = phonemes
-                    singleToken.rating = rating
-                    
+                if table.phonemes[index] == nil {
+                    let (phonemes, rating) = processToken(table[index], context: context)
+                    table.phonemes[index] = phonemes
+                    table.rating[index] = rating
                 }
-                context = tokenContext(context: context, phonemes: singleToken.phonemes, token: singleToken)
-            } else if let tokenGroup = word as? [MToken] {
+                context = tokenContext(context: context, phonemes: table.phonemes[index], text: table.text[index], tag: table.tag[index])
+            case .group(let range):
                 // Группа токенов - сложная логика как в Python
-                processTokenGroup(tokenGroup, context: &context)
-            }
-        }
-        
-        // Финальная обработка - собираем токены и убираем группы
-        var finalTokens: [MToken] = []
-        for word in words {
-            if let singleToken = word as? MToken {
-                finalTokens.append(singleToken)
-            } else if let tokenGroup = word as? [MToken] {
-                let mergedToken = mergeTokens(tokenGroup, unk: unk)
-                finalTokens.append(mergedToken)
+                processTokenGroup(range, in: &table, context: &context)
             }
         }
         
         // Собираем результат как в Python: result = ''.join((self.unk if tk.phonemes is None else tk.phonemes) + tk.whitespace for tk in tokens)
-        let phonemeString = finalTokens.map { token in
+        // Группы схлопываются в один токен, для каждого запоминаем диапазон фонем
+        var phonemeString = ""
+        var spans: [G2PTokenSpan] = []
+        spans.reserveCapacity(table.words.count)
+        var offset = 0
+        for word in table.words {
+            let token: MToken
+            switch word {
+            case .single(let index):
+                token = table[index]
+            case .group(let range):
+                token = mergeTokens(table.tokens(in: range), unk: unk)
+            }
             let phonemes = token.phonemes ?? unk
-            return phonemes + token.whitespace
-        }.joined()
+            let length = phonemes.unicodeScalars.count
+            spans.append(G2PTokenSpan(
+                text: token.text,
+                tag: token.tag,
+                whitespace: token.whitespace,
+                phonemes: offset..<(offset + length),
+                rating: token.phonemes == nil ? nil : token.rating ?? token.underscore.rating
+            ))
+            phonemeString += phonemes
+            phonemeString += token.whitespace
+            offset += length + token.whitespace.unicodeScalars.count
+        }
         
         print("🔍 Final phoneme string: \"\(phonemeString)\"")
         
-        return G2PResult(phonemeString: phonemeString, tokens: finalTokens)
+        return G2PResult(phonemeString: phonemeString, tokens: spans)
+    }
+    
+    /// Фонемизация длинного документа по предложениям.
+    ///
+    /// Текст режется на предложения (`SentenceSplitter`), каждое проходит полный
+    /// `convert` со своим обратным проходом `TokenContext`, и результаты
+    /// склеиваются в исходном порядке. Одновременно обрабатывается не больше
+    /// `maxConcurrency` предложений. POS-теги получаются заранее батчами
+    /// (`tagBatch`), параллельно идут токенизация, лексикон и разрешение групп.
+    public func convertDocument(_ text: String, maxConcurrency: Int = ProcessInfo.processInfo.activeProcessorCount) async throws -> G2PResult {
+        let sentences = SentenceSplitter.split(text).map { G2PEn.preprocess(String($0)) }
+        guard sentences.count > 1 else {
+            return try convert(sentences.first?.result ?? "")
+        }
+        // Теггер вызывается батчами по несколько предложений, дальше предложения независимы
+        let tagged = try tagBatch(sentences.map { $0.result })
+
+        var results = [G2PResult?](repeating: nil, count: sentences.count)
+        try await withThrowingTaskGroup(of: (Int, G2PResult).self) { group in
+            var nextIndex = 0
+            // Скользящее окно: новое предложение запускается по завершении предыдущего
+            while nextIndex < min(max(maxConcurrency, 1), sentences.count) {
+                let index = nextIndex
+                group.addTask { (index, self.convert(sentences[index], tagged: tagged[index])) }
+                nextIndex += 1
+            }
+            while let (index, result) = try await group.next() {
+                results[index] = result
+                if nextIndex < sentences.count {
+                    let index = nextIndex
+                    group.addTask { (index, self.convert(sentences[index], tagged: tagged[index])) }
+                    nextIndex += 1
+                }
+            }
+        }
+
+        return G2PEn.merge(results.compactMap { $0 })
+    }
+
+    /// Склейка результатов предложений через пробел
+    static func merge(_ results: [G2PResult]) -> G2PResult {
+        var phonemeString = ""
+        var tokens: [G2PTokenSpan] = []
+        var offset = 0
+        for result in results {
+            if !phonemeString.isEmpty && !result.phonemeString.isEmpty {
+                phonemeString += " "
+                offset += 1
+                if let last = tokens.indices.last, tokens[last].whitespace.isEmpty {
+                    tokens[last].whitespace = " "
+                }
+            }
+            phonemeString += result.phonemeString
+            for var token in result.tokens {
+                token.phonemes = (token.phonemes.lowerBound + offset)..<(token.phonemes.upperBound + offset)
+                tokens.append(token)
+            }
+            offset += result.phonemeString.unicodeScalars.count
+        }
+        return G2PResult(phonemeString: phonemeString, tokens: tokens)
+    }
+    
+    // MARK: - POS Tagging
+    
+    /// Метрики вызовов POS-теггера
+    public struct TaggerStatistics: Sendable {
+        /// Вызовы модели теггера
+        public internal(set) var calls = 0
+        /// Предложения (тексты), получившие теги
+        public internal(set) var sentences = 0
+        /// Батчи, теги которых не удалось разложить по предложениям
+        public internal(set) var batchFallbacks = 0
+        /// Предложения без POS-зависимых слов, размеченные `RuleBasedTagger` без вызова модели
+        public internal(set) var skipped = 0
+        
+        public var sentencesPerCall: Double {
+            return calls == 0 ? 0 : Double(sentences) / Double(calls)
+        }
+        
+        /// Доля предложений, для которых теггер не вызывался
+        public var skipRate: Double {
+            let total = sentences + skipped
+            return total == 0 ? 0 : Double(skipped) / Double(total)
+        }
+    }
+    
+    public var taggerStatistics: TaggerStatistics {
+        statisticsLock.lock()
+        defer { statisticsLock.unlock() }
+        return taggerCounters
+    }
+    
+    private func recordTagging(calls: Int, sentences: Int, fallbacks: Int = 0, skipped: Int = 0) {
+        statisticsLock.lock()
+        defer { statisticsLock.unlock() }
+        taggerCounters.calls += calls
+        taggerCounters.sentences += sentences
+        taggerCounters.batchFallbacks += fallbacks
+        taggerCounters.skipped += skipped
+    }
+    
+    /// Теги по правилам, если в тексте нет слов, произношение которых зависит от тега
+    private func ruleBasedTags(_ text: String) -> [(String, String)]? {
+        guard skipsUnambiguousTagging, let pairs = RuleBasedTagger.tag(text, lexicon: lexicon) else {
+            return nil
+        }
+        recordTagging(calls: 0, sentences: 0, skipped: 1)
+        return pairs
+    }
+    
+    /// Один вызов теггера. Потокобезопасность модели не гарантируется - вызовы сериализуем
+    private func predictTags(_ text: String) throws -> [(String, String)] {
+        postaggerLock.lock()
+        defer { postaggerLock.unlock() }
+        return try postagger.get().predict(text: text)
+    }
+    
+    /// doc = self.nlp(text) - используем SwiftPOSTagger
+    private func tag(_ text: String) throws -> [(String, String)] {
+        if let pairs = ruleBasedTags(text) {
+            return pairs
+        }
+        let pairs = try predictTags(text)
+        recordTagging(calls: 1, sentences: 1)
+        return pairs
+    }
+    
+    /// Теги для многих предложений: несколько предложений на вызов теггера.
+    ///
+    /// Если токены батча не раскладываются по предложениям, его предложения
+    /// тегируются по одному.
+    func tagBatch(_ texts: [String]) throws -> [[(String, String)]] {
+        var result = [[(String, String)]](repeating: [], count: texts.count)
+        
+        // Предложения без POS-зависимых слов размечаются правилами, остальные - моделью
+        var pending: [Int] = []
+        for (index, text) in texts.enumerated() {
+            if let pairs = ruleBasedTags(text) {
+                result[index] = pairs
+            } else {
+                pending.append(index)
+            }
+        }
+        
+        let pendingTexts = pending.map { texts[$0] }
+        for batch in POSTagBatcher.pack(pendingTexts) {
+            let slice = pendingTexts[batch]
+            if slice.count > 1 {
+                let pairs = try predictTags(POSTagBatcher.join(slice))
+                if let scattered = POSTagBatcher.scatter(pairs, over: slice) {
+                    recordTagging(calls: 1, sentences: slice.count)
+                    for (offset, pairs) in scattered.enumerated() {
+                        result[pending[batch.lowerBound + offset]] = pairs
+                    }
+                    continue
+                }
+                recordTagging(calls: 1, sentences: 0, fallbacks: 1)
+            }
+            for index in batch {
+                result[pending[index]] = try predictTags(pendingTexts[index])
+                recordTagging(calls: 1, sentences: 1)
+            }
+        }
+        return result
     }
     
+    // MARK: - Tokenization
+    
     /// Токенизация текста точно как в Python G2P.tokenize
     public func tokenize(text: String, tokens: [String], features: [Int: Any]) throws -> [MToken] {
-        
-        // doc = self.nlp(text) - используем SwiftPOSTagger
-        let tokenTagPairs = try postagger.predict(text: text)
-        
+        return makeTokens(from: try tag(text), features: features)
+    }
+    
+    /// MToken из пар (токен, тег) теггера с примененными фичами
+    private func makeTokens(from tokenTagPairs: [(String, String)], features: [Int: Any]) -> [MToken] {
         // Создаем MToken объекты как в Python
         var mutableTokens: [MToken] = []
         for (index, (tokenText, tag)) in tokenTagPairs.enumerated() {
@@ -123,7 +328,8 @@ public class G2PEn: G2P {
         // Мы делаем простое выравнивание по индексам
         for (featureIndex, featureValue) in features {
             if featureIndex < mutableTokens.count {
-                let token = mutableTokens[featureIndex]
+                var token = mutableTokens[featureIndex]
+                defer { mutableTokens[featureIndex] = token }
                 
                 // assert isinstance(v, str) or isinstance(v, int) or v in (0.5, -0.5)
                 if let intValue = featureValue as? Int {
@@ -227,12 +433,12 @@ public class G2PEn: G2P {
     
     /// Проверяет нужно ли объединять апостроф
     private func shouldCombineApostrophe(word: String, suffix: String) -> Bool {
-        let commonContractions = [
-            "s", "t", "d", "m", "re", "ve", "ll"  // 's, 't, 'd, 'm, 're, 've, 'll
-        ]
-        return commonContractions.contains(suffix.lowercased())
+        return G2PEn.commonContractions.contains(suffix.lowercased())
     }
     
+    // 's, 't, 'd, 'm, 're, 've, 'll
+    private static let commonContractions: Set<String> = ["s", "t", "d", "m", "re", "ve", "ll"]
+    
     /// Возвращает токенизацию как в Python spaCy
     private func getSpacyTokenization(for word: String) -> [String] {
         let lowered = word.lowercased()
@@ -292,87 +498,115 @@ public class G2PEn: G2P {
     }
     
     /// merge_tokens функция точно как в Python
-    private func mergeTokens(_ tokens: [MToken], unk: String?) -> MToken {
+    ///
+    /// Один проход: каждый токен из `TokenTable.tokens(in:)` собирается из
+    /// столбцов ровно один раз.
+    private func mergeTokens<Tokens: Sequence>(_ tokens: Tokens, unk: String?) -> MToken where Tokens.Element == MToken {
+        var first: MToken?
+        var last: MToken?
         // stress = {tk._.stress for tk in tokens if tk._.stress is not None}
-        let stressValues = Set(tokens.compactMap { $0.underscore.stress })
-        
+        var stress: Double?
+        var hasSeveralStresses = false
         // currency = {tk._.currency for tk in tokens if tk._.currency is not None}
-        let currencyValues = Set(tokens.compactMap { $0.underscore.currency })
-        
+        var currency: String?
         // rating = {tk._.rating for tk in tokens}
-        let ratingValues = tokens.map { $0.underscore.rating }
+        var rating: Int?
+        var hasNilRating = false
+        var numFlags = Set<Character>()
+        var phonemes = ""
+        var text = ""
+        var tag = ""
+        var bestScore = -1
         
-        // Обработка фонем
-        let phonemes: String?
-        if unk == nil {
-            phonemes = nil
-        } else {
-            var phonemesStr = ""
-            for tk in tokens {
+        for tk in tokens {
+            if let value = tk.underscore.stress {
+                if let existing = stress, existing != value {
+                    hasSeveralStresses = true
+                }
+                stress = value
+            }
+            if let value = tk.underscore.currency {
+                currency = max(currency ?? value, value)
+            }
+            if let value = tk.underscore.rating {
+                rating = min(rating ?? value, value)
+            } else {
+                hasNilRating = true
+            }
+            numFlags.formUnion(tk.underscore.numFlags)
+            
+            if let unk = unk {
                 // if tk._.prespace and phonemes and not phonemes[-1].isspace() and tk.phonemes:
-                if tk.underscore.prespace && !phonemesStr.isEmpty && !phonemesStr.last!.isWhitespace && tk.phonemes != nil {
-                    phonemesStr += " "
+                if tk.underscore.prespace && !phonemes.isEmpty && !phonemes.last!.isWhitespace && tk.phonemes != nil {
+                    phonemes += " "
                 }
                 // phonemes += unk if tk.phonemes is None else tk.phonemes
-                phonemesStr += tk.phonemes ?? unk!
+                phonemes += tk.phonemes ?? unk
             }
-            phonemes = phonemesStr
-        }
-        
-        // text=''.join(tk.text + tk.whitespace for tk in tokens[:-1]) + tokens[-1].text
-        var text = ""
-        for (index, tk) in tokens.enumerated() {
-            if index < tokens.count - 1 {
-                text += tk.text + tk.whitespace
-            } else {
-                text += tk.text
+            
+            // text=''.join(tk.text + tk.whitespace for tk in tokens[:-1]) + tokens[-1].text
+            if let previous = last {
+                text += previous.whitespace
+            }
+            text += tk.text
+            
+            // tag=max(tokens, key=lambda tk: sum(1 if c == c.lower() else 2 for c in tk.text)).tag
+            let score = tk.text.reduce(0) { sum, c in sum + (c.isLowercase ? 1 : 2) }
+            if score > bestScore {
+                bestScore = score
+                tag = tk.tag
+            }
+            
+            if first == nil {
+                first = tk
             }
+            last = tk
         }
         
-        // tag=max(tokens, key=lambda tk: sum(1 if c == c.lower() else 2 for c in tk.text)).tag
-        let selectedToken = tokens.max { tk1, tk2 in
-            let score1 = tk1.text.reduce(0) { sum, c in sum + (c.isLowercase ? 1 : 2) }
-            let score2 = tk2.text.reduce(0) { sum, c in sum + (c.isLowercase ? 1 : 2) }
-            return score1 < score2
-        }!
+        guard let first = first, let last = last else {
+            preconditionFailure("mergeTokens needs at least one token")
+        }
         
         let mergedUnderscore = MToken.Underscore(
-            isHead: tokens[0].underscore.isHead,                               // is_head=tokens[0]._.is_head
+            isHead: first.underscore.isHead,                                   // is_head=tokens[0]._.is_head
             alias: nil,                                                        // alias=None
-            stress: stressValues.count == 1 ? stressValues.first : nil,       // stress=list(stress)[0] if len(stress) == 1 else None
-            currency: currencyValues.max(),                                    // currency=max(currency) if currency else None
-            numFlags: String(Set(tokens.flatMap { $0.underscore.numFlags }).sorted()), // num_flags=''.join(sorted({c for tk in tokens for c in tk._.num_flags}))
-            prespace: tokens[0].underscore.prespace,                          // prespace=tokens[0]._.prespace
-            rating: ratingValues.contains(nil) ? nil : ratingValues.compactMap { $0 }.min() // rating=None if None in rating else min(rating)
+            stress: hasSeveralStresses ? nil : stress,                         // stress=list(stress)[0] if len(stress) == 1 else None
+            currency: currency,                                                // currency=max(currency) if currency else None
+            numFlags: String(numFlags.sorted()),                               // num_flags=''.join(sorted({c for tk in tokens for c in tk._.num_flags}))
+            prespace: first.underscore.prespace,                               // prespace=tokens[0]._.prespace
+            rating: hasNilRating ? nil : rating                                // rating=None if None in rating else min(rating)
         )
         
         return MToken(
             text: text,
-            tag: selectedToken.tag,
-            whitespace: tokens.last!.whitespace,           // whitespace=tokens[-1].whitespace
-            phonemes: phonemes,
-            startTs: tokens.first!.startTs,               // start_ts=tokens[0].start_ts
-            endTs: tokens.last!.endTs,                    // end_ts=tokens[-1].end_ts
+            tag: tag,
+            whitespace: last.whitespace,                  // whitespace=tokens[-1].whitespace
+            phonemes: unk == nil ? nil : phonemes,
+            startTs: first.startTs,                       // start_ts=tokens[0].start_ts
+            endTs: last.endTs,                            // end_ts=tokens[-1].end_ts
             underscore: mergedUnderscore
         )
     }
     
     /// retokenize метод точно как в Python G2P.retokenize
-    public static func retokenize(tokens: [MToken]) -> [Any] {
+    ///
+    /// Вместо `[Any]` из токенов и списков токенов возвращает таблицу токенов,
+    /// в которой слова - индексы одиночных токенов или диапазоны групп.
+    static func retokenize(tokens: [MToken]) -> TokenTable {
         print("🔍 G2P.retokenize input: \(tokens.count) tokens")
         
-        var words: [Any] = []
+        var table = TokenTable(capacity: tokens.count)
         var currency: String? = nil
         
         for (i, token) in tokens.enumerated() {
-            let tks: [MToken]
+            let start = table.count
             
             // if token._.alias is None and token.phonemes is None:
             if token.underscore.alias == nil && token.phonemes == nil {
                 // tks = [replace(token, text=t, whitespace='', _=MToken.Underscore(...)) for t in subtokenize(token.text)]
                 let subtokens = subtokenize(token.text)
-                tks = subtokens.map { subtext in
-                    let newToken = MToken(
+                for subtext in subtokens {
+                    table.append(MToken(
                         text: subtext,
                         tag: token.tag,
                         whitespace: "", // изначально пустой
@@ -382,117 +616,103 @@ public class G2PEn: G2P {
                             numFlags: token.underscore.numFlags,
                             prespace: false
                         )
-                    )
-                    return newToken
+                    ))
                 }
                 print("🔍 G2P.retokenize subtokenized '\(token.text)' into: \(subtokens)")
             } else {
-                tks = [token]
+                table.append(token)
             }
+            let tks = start..<table.count
             
             // tks[-1].whitespace = token.whitespace
-            tks.last?.whitespace = token.whitespace
-            print("🔍 G2P.retokenize processing subtokens: \(tks.map { "'\($0.text)'(ws:'\($0.whitespace)')" })")
+            table.whitespace[tks.upperBound - 1] = token.whitespace
+            print("🔍 G2P.retokenize processing subtokens: \(tks.map { "'\(table.text[$0])'(ws:'\(table.whitespace[$0])')" })")
             
-            for (j, tk) in tks.enumerated() {
+            for tk in tks {
+                let j = tk - start
+                let text = table.text[tk]
+                let tag = table.tag[tk]
+                
                 // if tk._.alias is not None or tk.phonemes is not None: pass
-                if tk.underscore.alias != nil || tk.phonemes != nil {
+                if table.alias[tk] != nil || table.phonemes[tk] != nil {
                     // pass - ничего не делаем
                 }
                 // elif tk.tag == '$' and tk.text in CURRENCIES:
-                else if tk.tag == "$" && ["$", "£", "€"].contains(tk.text) {
-                    currency = tk.text
-                    tk.phonemes = ""
-                    tk.underscore.rating = 4
-                    print("🔍 G2P.retokenize found currency: '\(tk.text)'")
+                else if tag == "$" && ["$", "£", "€"].contains(text) {
+                    currency = text
+                    table.phonemes[tk] = ""
+                    table.underscoreRating[tk] = 4
+                    print("🔍 G2P.retokenize found currency: '\(text)'")
                 }
                 // elif tk.tag == ':' and tk.text in ('-', '–'):
-                else if tk.tag == ":" && ["-", "–"].contains(tk.text) {
-                    tk.phonemes = "—"
-                    tk.underscore.rating = 3
-                    print("🔍 G2P.retokenize converted dash: '\(tk.text)' -> '—'")
+                else if tag == ":" && ["-", "–"].contains(text) {
+                    table.phonemes[tk] = "—"
+                    table.underscoreRating[tk] = 3
+                    print("🔍 G2P.retokenize converted dash: '\(text)' -> '—'")
                 }
                 // elif tk.tag in PUNCT_TAGS and not all(97 <= ord(c.lower()) <= 122 for c in tk.text):
-                else if isPunctTag(tk.tag) && !tk.text.allSatisfy({ c in c.isLetter }) {
-                    let punctMap = ["-LRB-": "(", "-RRB-": ")", "``": "\u{201C}", "\"\"": "\u{201D}", "''": "\u{201D}"]
-                    tk.phonemes = punctMap[tk.tag] ?? tk.text.filter { ";:,.!?—…\"".contains($0) }.map(String.init).joined()
-                    tk.underscore.rating = 4
-                    print("🔍 G2P.retokenize handled punctuation: '\(tk.text)' -> '\(tk.phonemes ?? "")'")
+                else if isPunctTag(tag) && !text.allSatisfy({ c in c.isLetter }) {
+                    table.phonemes[tk] = G2PEn.punctMap[tag] ?? text.filter { G2PEn.punctPhonemes.contains($0) }.map(String.init).joined()
+                    table.underscoreRating[tk] = 4
+                    print("🔍 G2P.retokenize handled punctuation: '\(text)' -> '\(table.phonemes[tk] ?? "")'")
                 }
                 // elif currency is not None:
                 else if currency != nil {
-                    if tk.tag != "CD" {
+                    if tag != "CD" {
                         currency = nil
-                    } else if j + 1 == tks.count && (i + 1 == tokens.count || tokens[i + 1].tag != "CD") {
-                        tk.underscore.currency = currency
-                        print("🔍 G2P.retokenize assigned currency '\(currency!)' to '\(tk.text)'")
+                    } else if tk + 1 == tks.upperBound && (i + 1 == tokens.count || tokens[i + 1].tag != "CD") {
+                        table.currency[tk] = currency
+                        print("🔍 G2P.retokenize assigned currency '\(currency!)' to '\(text)'")
                     }
                 }
                 // elif 0 < j < len(tks)-1 and tk.text == '2' and (tks[j-1].text[-1]+tks[j+1].text[0]).isalpha():
-                else if j > 0 && j < tks.count - 1 && tk.text == "2" {
-                    let prevLast = tks[j-1].text.last
-                    let nextFirst = tks[j+1].text.first
+                else if j > 0 && tk < tks.upperBound - 1 && text == "2" {
+                    let prevLast = table.text[tk - 1].last
+                    let nextFirst = table.text[tk + 1].first
                     if let prev = prevLast, let next = nextFirst, prev.isLetter && next.isLetter {
-                        tk.underscore.alias = "to"
+                        table.alias[tk] = "to"
                         print("🔍 G2P.retokenize converted '2' to 'to' between letters")
                     }
                 }
                 
                 // Логика группировки токенов
                 // if tk._.alias is not None or tk.phonemes is not None: words.append(tk)
-                if tk.underscore.alias != nil || tk.phonemes != nil {
-                    words.append(tk)
-                    print("🔍 G2P.retokenize added token with alias/phonemes: '\(tk.text)'")
+                if table.alias[tk] != nil || table.phonemes[tk] != nil {
+                    table.words.append(.single(tk))
+                    print("🔍 G2P.retokenize added token with alias/phonemes: '\(text)'")
                 }
                 // elif words and isinstance(words[-1], list) and not words[-1][-1].whitespace:
-                else if !words.isEmpty,
-                        let lastWordArray = words.last as? [MToken],
-                        lastWordArray.last?.whitespace.isEmpty == true {
-                    // Добавляем к существующей группе
-                    tk.underscore.isHead = false
-                    var updatedArray = lastWordArray
-                    updatedArray.append(tk)
-                    words[words.count - 1] = updatedArray
-                    print("🔍 G2P.retokenize added '\(tk.text)' to existing group (isHead=false)")
-                }
                 // else: words.append(tk if tk.whitespace else [tk])
-                else {
-                    print("🔍 G2P.retokenize token '\(tk.text)' has whitespace: '\(tk.whitespace)' (isEmpty: \(tk.whitespace.isEmpty))")
-                    if !tk.whitespace.isEmpty {
-                        // Токен с whitespace - добавляем как отдельный
-                        words.append(tk)
-                        print("🔍 G2P.retokenize added single token '\(tk.text)' (has whitespace)")
-                    } else {
-                        // Токен без whitespace - создаем новую группу или добавляем к последней группе
-                        print("🔍 G2P.retokenize current words count: \(words.count), last is array: \(words.last is [MToken])")
-                        if !words.isEmpty, let lastWordArray = words.last as? [MToken] {
-                            // Последний элемент - группа, добавляем к ней
-                            tk.underscore.isHead = false
-                            var updatedArray = lastWordArray
-                            updatedArray.append(tk)
-                            words[words.count - 1] = updatedArray
-                            print("🔍 G2P.retokenize added '\(tk.text)' to existing group (isHead=false)")
-                        } else {
-                            // Создаем новую группу
-                            words.append([tk])
-                            print("🔍 G2P.retokenize created new group with '\(tk.text)'")
-                        }
-                    }
+                // (токен без пробела после группы тоже присоединяется к ней)
+                else if case .group(let group)? = table.words.last,
+                        table.whitespace[group.upperBound - 1].isEmpty || table.whitespace[tk].isEmpty {
+                    // Добавляем к существующей группе - токены группы идут подряд
+                    table.isHead[tk] = false
+                    table.words[table.words.count - 1] = .group(group.lowerBound..<(tk + 1))
+                    print("🔍 G2P.retokenize added '\(text)' to existing group (isHead=false)")
+                }
+                else if !table.whitespace[tk].isEmpty {
+                    // Токен с whitespace - добавляем как отдельный
+                    table.words.append(.single(tk))
+                    print("🔍 G2P.retokenize added single token '\(text)' (has whitespace)")
+                } else {
+                    // Создаем новую группу
+                    table.words.append(.group(tk..<(tk + 1)))
+                    print("🔍 G2P.retokenize created new group with '\(text)'")
                 }
             }
         }
         
         // return [w[0] if isinstance(w, list) and len(w) == 1 else w for w in words]
-        let result = words.map { word -> Any in
-            if let tokenArray = word as? [MToken], tokenArray.count == 1 {
-                return tokenArray[0]
+        for (w, word) in table.words.enumerated() {
+            if case .group(let range) = word, range.count == 1 {
+                table.words[w] = .single(range.lowerBound)
             }
-            return word
         }
         
-        print("🔍 G2P.retokenize output: \(result.count) words")
+        print("🔍 G2P.retokenize output: \(table.words.count) words")
         
-        return result
+        return table
     }
     
     /// Функция subtokenize - упрощенная версия Python regex
@@ -525,30 +745,44 @@ public class G2PEn: G2P {
     
     /// Проверка является ли тег пунктуационным
     private static func isPunctTag(_ tag: String) -> Bool {
-        let punctTags = [".", ",", "-LRB-", "-RRB-", "``", "\"\"", "''", ":", "$", "#", "NFP"]
         return punctTags.contains(tag)
     }
     
+    private static let punctTags: Set<String> = [".", ",", "-LRB-", "-RRB-", "``", "\"\"", "''", ":", "$", "#", "NFP"]
+    private static let punctMap = ["-LRB-": "(", "-RRB-": ")", "``": "\u{201C}", "\"\"": "\u{201D}", "''": "\u{201D}"]
+    private static let punctPhonemes = Set(";:,.!?—…\"")
+    private static let subtokenJunks = Set("',-._''/")
+    
     
     // MARK: - Token processing helpers
     
+    /// Метрики кеша слов
+    public var wordCacheStatistics: G2PWordCache.Statistics {
+        return wordCache.statistics()
+    }
+    
+    /// Очистка кеша слов (например, после смены словаря)
+    public func clearWordCache() {
+        wordCache.removeAll()
+    }
+    
+    /// Фонемизация токена через лексикон с кешированием по слову, тегу и контексту
+    private func processToken(_ token: MToken, context: TokenContext) -> (String?, Int?) {
+        return wordCache.processToken(token, context: context, in: lexicon)
+    }
+    
     /// Обработка контекста токена (как token_context в Python)
-    private func tokenContext(context: TokenContext, phonemes: String?, token: MToken) -> TokenContext {
+    private func tokenContext(context: TokenContext, phonemes: String?, text: String, tag: String) -> TokenContext {
         var vowel = context.futureVowel
         
         if let phonemes = phonemes {
             // vowel = next((None if c in NON_QUOTE_PUNCTS else (c in VOWELS) for c in ps if any(c in s for s in (VOWELS, CONSONANTS, NON_QUOTE_PUNCTS))), vowel)
-            let vowelChars = Set("AIOQWYaiuæɑɒɔəɛɜɪʊʌᵻ")
-            let consonantChars = Set("bdfhjklmnpstvwzðŋɡɹɾʃʒʤʧθ")
-            let nonQuotePuncts = Set(";:,.!?—…")
-            
             for char in phonemes {
-                _ = String(char)
-                if vowelChars.contains(char) || consonantChars.contains(char) || nonQuotePuncts.contains(char) {
-                    if nonQuotePuncts.contains(char) {
+                if G2PEn.vowelChars.contains(char) || G2PEn.consonantChars.contains(char) || G2PEn.nonQuotePuncts.contains(char) {
+                    if G2PEn.nonQuotePuncts.contains(char) {
                         vowel = nil
                     } else {
-                        vowel = vowelChars.contains(char)
+                        vowel = G2PEn.vowelChars.contains(char)
                     }
                     break
                 }
@@ -556,87 +790,88 @@ public class G2PEn: G2P {
         }
         
         // future_to = token.text in ('to', 'To') or (token.text == 'TO' and token.tag in ('TO', 'IN'))
-        let futureTo = token.text == "to" || token.text == "To" || (token.text == "TO" && (token.tag == "TO" || token.tag == "IN"))
+        let futureTo = text == "to" || text == "To" || (text == "TO" && (tag == "TO" || tag == "IN"))
         
         return TokenContext(futureVowel: vowel, futureTo: futureTo)
     }
     
+    private static let vowelChars = Set("AIOQWYaiuæɑɒɔəɛɜɪʊʌᵻ")
+    private static let consonantChars = Set("bdfhjklmnpstvwzðŋɡɹɾʃʒʤʧθ")
+    private static let nonQuotePuncts = Set(";:,.!?—…")
+    
     /// Обработка группы токенов (сложная логика из Python)
-    private func processTokenGroup(_ tokenGroup: [MToken], context: inout TokenContext) {
-        var left = 0
-        var right = tokenGroup.count
+    private func processTokenGroup(_ group: Range<Int>, in table: inout TokenTable, context: inout TokenContext) {
+        var left = group.lowerBound
+        var right = group.upperBound
 
         while left < right {
             // Проверяем есть ли уже фонемы или алиасы
-            let hasPhonemes = tokenGroup[left..<right].contains { $0.underscore.alias != nil || $0.phonemes != nil }
+            let hasPhonemes = (left..<right).contains { table.alias[$0] != nil || table.phonemes[$0] != nil }
 
             let mergedToken: MToken?
             if hasPhonemes {
                 mergedToken = nil
             } else {
-                mergedToken = mergeTokens(Array(tokenGroup[left..<right]), unk: nil)
+                mergedToken = mergeTokens(table.tokens(in: left..<right), unk: nil)
             }
 
             let (phonemes, rating): (String?, Int?)
             if let mergedToken = mergedToken {
-                (phonemes, rating) = lexicon.processToken(mergedToken, context: context)
+                (phonemes, rating) = processToken(mergedToken, context: context)
             } else {
                 (phonemes, rating) = (nil, nil)
             }
 
-            if phonemes != nil {
+            if let mergedToken = mergedToken, phonemes != nil {
                 // Успешно найдены фонемы для группы
-                tokenGroup[left].phonemes = phonemes
-                tokenGroup[left].rating = rating
+                table.phonemes[left] = phonemes
+                table.rating[left] = rating
 
                 // Очищаем остальные токены в группе
                 for i in (left + 1)..<right {
-                    tokenGroup[i].phonemes = ""
-                    tokenGroup[i].rating = rating
+                    table.phonemes[i] = ""
+                    table.rating[i] = rating
                 }
 
-                context = tokenContext(context: context, phonemes: phonemes, token: mergedToken!)
+                context = tokenContext(context: context, phonemes: phonemes, text: mergedToken.text, tag: mergedToken.tag)
                 right = left
-                left = 0
+                left = group.lowerBound
             } else if left + 1 < right {
                 left += 1
             } else {
                 // Не можем найти фонемы, обрабатываем последний токен
                 right -= 1
-                let currentToken = tokenGroup[right]
 
-                if currentToken.phonemes == nil {
+                if table.phonemes[right] == nil {
                     // Проверяем на junk символы
-                    let subtokenJunks = Set("',-._''/")
-                    if currentToken.text.allSatisfy({ subtokenJunks.contains($0) }) {
-                        currentToken.phonemes = ""
-                        currentToken.underscore.rating = 3
+                    if table.text[right].allSatisfy({ G2PEn.subtokenJunks.contains($0) }) {
+                        table.phonemes[right] = ""
+                        table.underscoreRating[right] = 3
                     }
                 }
-                left = 0
+                left = group.lowerBound
             }
         }
 
         // Resolve tokens logic из Python
-        resolveTokens(tokenGroup)
+        resolveTokens(group, in: &table)
     }
     
     /// Разрешение токенов (как resolve_tokens в Python)
-    private func resolveTokens(_ tokens: [MToken]) {
+    private func resolveTokens(_ group: Range<Int>, in table: inout TokenTable) {
         // text = ''.join(tk.text + tk.whitespace for tk in tokens[:-1]) + tokens[-1].text
         var text = ""
-        for (i, token) in tokens.enumerated() {
-            if i < tokens.count - 1 {
-                text += token.text + token.whitespace
+        for i in group {
+            if i < group.upperBound - 1 {
+                text += table.text[i] + table.whitespace[i]
             } else {
-                text += token.text
+                text += table.text[i]
             }
         }
         
         // prespace = ' ' in text or '/' in text or len({0 if c.isalpha() else (1 if is_digit(c) else 2) for c in text if c not in SUBTOKEN_JUNKS}) > 1
-        let subtokenJunks = Set("',-._''/")
         let categories = Set(text.compactMap { char -> Int? in
-            guard !subtokenJunks.contains(char) else { return nil }
+            guard !G2PEn.subtokenJunks.contains(char) else { return nil }
             if char.isLetter { return 0 }
             else if char.isNumber { return 1 }
             else { return 2 }
@@ -644,9 +879,9 @@ public class G2PEn: G2P {
         let prespace = text.contains(" ") || text.contains("/") || categories.count > 1
         
         // Устанавливаем prespace для токенов начиная со второго
-        for i in 1..<tokens.count {
-            if tokens[i].phonemes != nil {
-                tokens[i].underscore.prespace = prespace
+        for i in group.dropFirst() {
+            if table.phonemes[i] != nil {
+                table.prespace[i] = prespace
             }
         }
         
@@ -662,15 +897,15 @@ public class G2PEn: G2P {
             }
         }
         
-        let indices: [(Bool, Int, Int)] = tokens.enumerated().compactMap { (i, token) in
-            guard let phonemes = token.phonemes, !phonemes.isEmpty else { return nil }
+        let indices: [(Bool, Int, Int)] = group.compactMap { i in
+            guard let phonemes = table.phonemes[i], !phonemes.isEmpty else { return nil }
             return (phonemes.contains(primaryStress), stressWeight(phonemes), i)
         }
         
-        if indices.count == 2 && tokens[indices[0].2].text.count == 1 {
+        if indices.count == 2 && table.text[indices[0].2].count == 1 {
             let i = indices[1].2
-            if let phonemes = tokens[i].phonemes {
-                tokens[i].phonemes = applyStress(phonemes, stress: -0.5)
+            if let phonemes = table.phonemes[i] {
+                table.phonemes[i] = applyStress(phonemes, stress: -0.5)
             }
             return
         } else if indices.count < 2 || indices.filter({ $0.0 }).count <= (indices.count + 1) / 2 {
@@ -681,8 +916,8 @@ public class G2PEn: G2P {
         let toReduce = Array(sortedIndices.prefix(indices.count / 2))
         
         for (_, _, i) in toReduce {
-            if let phonemes = tokens[i].phonemes {
-                tokens[i].phonemes = applyStress(phonemes, stress: -0.5)
+            if let phonemes = table.phonemes[i] {
+                table.phonemes[i] = applyStress(phonemes, stress: -0.5)
             }
         }
     }
@@ -701,73 +936,23 @@ public class G2PEn: G2P {
     }
     
     /// Структура результата предобработки (как в Python: result, tokens, features)
-    public struct PreprocessResult {
+    /// `features` содержит только Int, Double и String, поэтому результат можно передавать между задачами
+    public struct PreprocessResult: @unchecked Sendable {
         let result: String
         let tokens: [String] 
         let features: [Int: Any]
     }
     
     /// Предобработка текста точно как в Python G2P.preprocess
+    ///
+    /// Один проход по UTF-8 байтам (`TextNormalizer`) вместо regex и `NSRange`-конвертаций.
     public static func preprocess(_ text: String) -> PreprocessResult {
         print("🔍 G2P.preprocess input: \"\(text)\"")
-        
-        var result = ""
-        var tokens: [String] = []
-        var features: [Int: Any] = [:]
-        var lastEnd = 0
-        
-        // text = text.lstrip() - убираем пробелы слева
-        let trimmedText = text.trimmingCharacters(in: .whitespacesAndNewlines)
-        
-        // Regex для markdown ссылок: \[([^\]]+)\]\(([^\)]*)\)
-        let linkRegex = try! NSRegularExpression(pattern: #"\[([^\]]+)\]\(([^\)]*)\)"#)
-        let matches = linkRegex.matches(in: trimmedText, range: NSRange(trimmedText.startIndex..., in: trimmedText))
-        
-        for match in matches {
-            // result += text[last_end:m.start()]
-            let beforeRange = NSRange(location: lastEnd, length: match.range.location - lastEnd)
-            if let beforeSwiftRange = Range(beforeRange, in: trimmedText) {
-                let beforeText = String(trimmedText[beforeSwiftRange])
-                result += beforeText
-                // tokens.extend(text[last_end:m.start()].split())
-                tokens.append(contentsOf: beforeText.components(separatedBy: .whitespacesAndNewlines).filter { !$0.isEmpty })
-            }
-            
-            if let textRange = Range(match.range(at: 1), in: trimmedText),
-               let featureRange = Range(match.range(at: 2), in: trimmedText) {
-                
-                let linkText = String(trimmedText[textRange])      // m.group(1)
-                let featureString = String(trimmedText[featureRange]) // m.group(2)
-                
-                // Парсим фичу согласно Python логике
-                let f = parseFeature(featureString)
-                if f != nil {
-                    features[tokens.count] = f
-                }
-                
-                result += linkText
-                tokens.append(linkText)
-                lastEnd = match.range.location + match.range.length
-            }
-        }
-        
-        // if last_end < len(text): result += text[last_end:]; tokens.extend(text[last_end:].split())
-        if lastEnd < trimmedText.count {
-            let remainingRange = NSRange(location: lastEnd, length: trimmedText.count - lastEnd)
-            if let remainingSwiftRange = Range(remainingRange, in: trimmedText) {
-                let remainingText = String(trimmedText[remainingSwiftRange])
-                result += remainingText
-                tokens.append(contentsOf: remainingText.components(separatedBy: .whitespacesAndNewlines).filter { !$0.isEmpty })
-            }
-        }
-        
-        let preprocessResult = PreprocessResult(result: result, tokens: tokens, features: features)
-        
-        return preprocessResult
+        return TextNormalizer.normalize(text)
     }
     
     /// Парсит фичи точно как в Python
-    private static func parseFeature(_ featureString: String) -> Any? {
+    static func parseFeature(_ featureString: String) -> Any? {
         var f = featureString
         
         // if is_digit(f[1 if f[:1] in ('-', '+') else 0:]):
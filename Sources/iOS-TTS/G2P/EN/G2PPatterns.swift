@@ -0,0 +1,56 @@
+import Foundation
+
+/// Ручные сканеры для простых шаблонов G2P вместо регулярных выражений.
+///
+/// Компиляция `NSRegularExpression` на порядки дороже сопоставления, а шаблоны
+/// ниже сводятся к проверке нескольких ASCII-байтов. Markdown-ссылки разбирает
+/// `TextNormalizer`.
+enum G2PPatterns {
+
+    /// `^[0-9]+$`
+    static func isASCIIDigits(_ text: String) -> Bool {
+        guard !text.utf8.isEmpty else { return false }
+        return text.utf8.allSatisfy { $0 >= UInt8(ascii: "0") && $0 <= UInt8(ascii: "9") }
+    }
+
+    /// `[a-z']+$` - хвост из строчных ASCII-букв и апострофов (суффикс числа: "st", "'s", "th")
+    static func lowercaseSuffix(_ word: String) -> Substring? {
+        let utf8 = word.utf8
+        var start = utf8.endIndex
+        while start > utf8.startIndex {
+            let previous = utf8.index(before: start)
+            let byte = utf8[previous]
+            guard (byte >= UInt8(ascii: "a") && byte <= UInt8(ascii: "z")) || byte == UInt8(ascii: "'") else {
+                break
+            }
+            start = previous
+        }
+        return start == utf8.endIndex ? nil : word[start...]
+    }
+
+    /// `(?i)vs\.?$`
+    static func endsWithVersus(_ word: String) -> Bool {
+        var bytes = word.utf8.reversed().makeIterator()
+        var last = bytes.next()
+        if last == UInt8(ascii: ".") {
+            last = bytes.next()
+        }
+        guard let s = last, let v = bytes.next() else { return false }
+        return (s | 0x20) == UInt8(ascii: "s") && (v | 0x20) == UInt8(ascii: "v")
+    }
+
+    /// `([bcdgklmnprstvxz])\1ing$|cking$` - удвоенная согласная перед -ing ("running", "packing")
+    static func hasDoubledConsonantIng(_ word: String) -> Bool {
+        let bytes = Array(word.utf8.suffix(5))
+        guard bytes.count == 5,
+              bytes[2] == UInt8(ascii: "i"), bytes[3] == UInt8(ascii: "n"), bytes[4] == UInt8(ascii: "g") else {
+            return false
+        }
+        if bytes[0] == UInt8(ascii: "c") && bytes[1] == UInt8(ascii: "k") {
+            return true
+        }
+        return bytes[0] == bytes[1] && doubledConsonants.contains(bytes[1])
+    }
+
+    private static let doubledConsonants = Set("bcdgklmnprstvxz".utf8)
+}
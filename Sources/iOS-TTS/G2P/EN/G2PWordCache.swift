@@ -0,0 +1,192 @@
+import Foundation
+
+/// Потокобезопасный LRU-кеш результатов `Lexicon.processToken`.
+///
+/// Ключ включает все, от чего зависит результат лексикона: слово (alias или
+/// текст), POS-тег, ударение, валюту, числовые флаги, `isHead` и биты
+/// `TokenContext`. Поэтому гетеронимы ("read", "live") кешируются отдельно
+/// для каждого тега.
+public final class G2PWordCache: @unchecked Sendable {
+
+    struct Key: Hashable, Sendable {
+        let word: String
+        let tag: String
+        let stress: Double?
+        let currency: String?
+        let numFlags: String
+        let isHead: Bool
+        let futureVowel: Bool?
+        let futureTo: Bool
+
+        init(token: MToken, context: TokenContext) {
+            self.word = token.underscore.alias ?? token.text
+            self.tag = token.tag
+            self.stress = token.underscore.stress
+            self.currency = token.underscore.currency
+            self.numFlags = token.underscore.numFlags
+            self.isHead = token.underscore.isHead
+            self.futureVowel = context.futureVowel
+            self.futureTo = context.futureTo
+        }
+    }
+
+    struct Value: Sendable {
+        let phonemes: String?
+        let rating: Int?
+    }
+
+    /// Метрики кеша
+    public struct Statistics: Sendable {
+        public let hits: Int
+        public let misses: Int
+        public let evictions: Int
+        public let count: Int
+        public let capacity: Int
+
+        public var hitRate: Double {
+            let total = hits + misses
+            return total == 0 ? 0 : Double(hits) / Double(total)
+        }
+    }
+
+    let capacity: Int
+
+    private var index: [Key: Int] = [:]
+    private var keys: [Key?]
+    private var values: [Value?]
+    // Двусвязный список по индексам слотов: head - самый свежий, tail - самый старый
+    private var previous: [Int]
+    private var next: [Int]
+    private var head = -1
+    private var tail = -1
+    private var used = 0
+
+    private var hits = 0
+    private var misses = 0
+    private var evictions = 0
+
+    private let lock = NSLock()
+
+    init(capacity: Int) {
+        self.capacity = max(capacity, 0)
+        self.keys = Array(repeating: nil, count: self.capacity)
+        self.values = Array(repeating: nil, count: self.capacity)
+        self.previous = Array(repeating: -1, count: self.capacity)
+        self.next = Array(repeating: -1, count: self.capacity)
+        index.reserveCapacity(self.capacity)
+    }
+
+    /// Возвращает закешированный результат или вычисляет и сохраняет его
+    func value(for key: Key, compute: () -> Value) -> Value {
+        guard capacity > 0 else { return compute() }
+
+        if let cached = lookup(key) {
+            return cached
+        }
+        // Лексикон вызывается вне блокировки - он неизменяем
+        let value = compute()
+        insert(value, for: key)
+        return value
+    }
+
+    /// `lexicon.processToken` через кеш
+    func processToken(_ token: MToken, context: TokenContext, in lexicon: Lexicon) -> (String?, Int?) {
+        let cached = value(for: Key(token: token, context: context)) {
+            let (phonemes, rating) = lexicon.processToken(token, context: context)
+            return Value(phonemes: phonemes, rating: rating)
+        }
+        return (cached.phonemes, cached.rating)
+    }
+
+    func statistics() -> Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return Statistics(hits: hits, misses: misses, evictions: evictions, count: used, capacity: capacity)
+    }
+
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        index.removeAll(keepingCapacity: true)
+        for slot in 0..<capacity {
+            keys[slot] = nil
+            values[slot] = nil
+            previous[slot] = -1
+            next[slot] = -1
+        }
+        head = -1
+        tail = -1
+        used = 0
+        hits = 0
+        misses = 0
+        evictions = 0
+    }
+
+    // MARK: - Private
+
+    private func lookup(_ key: Key) -> Value? {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard let slot = index[key] else {
+            misses += 1
+            return nil
+        }
+        hits += 1
+        moveToFront(slot)
+        return values[slot]
+    }
+
+    private func insert(_ value: Value, for key: Key) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        // Другой поток мог успеть вставить то же слово
+        if let slot = index[key] {
+            values[slot] = value
+            moveToFront(slot)
+            return
+        }
+
+        let slot: Int
+        if used < capacity {
+            slot = used
+            used += 1
+        } else {
+            slot = tail
+            unlink(slot)
+            if let evicted = keys[slot] {
+                index.removeValue(forKey: evicted)
+            }
+            evictions += 1
+        }
+
+        keys[slot] = key
+        values[slot] = value
+        index[key] = slot
+        linkAtFront(slot)
+    }
+
+    private func moveToFront(_ slot: Int) {
+        guard slot != head else { return }
+        unlink(slot)
+        linkAtFront(slot)
+    }
+
+    private func unlink(_ slot: Int) {
+        let prev = previous[slot]
+        let nxt = next[slot]
+        if prev >= 0 { next[prev] = nxt } else { head = nxt }
+        if nxt >= 0 { previous[nxt] = prev } else { tail = prev }
+        previous[slot] = -1
+        next[slot] = -1
+    }
+
+    private func linkAtFront(_ slot: Int) {
+        previous[slot] = -1
+        next[slot] = head
+        if head >= 0 { previous[head] = slot }
+        head = slot
+        if tail < 0 { tail = slot }
+    }
+}
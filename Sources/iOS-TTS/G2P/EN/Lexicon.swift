@@ -1,9 +1,9 @@
 import Foundation
 
 /// Контекст для обработки токенов (как TokenContext в Python)
-public class TokenContext {
-    var futureVowel: Bool? = nil
-    var futureTo: Bool = false
+public struct TokenContext: Sendable {
+    let futureVowel: Bool?
+    let futureTo: Bool
     
     public init(futureVowel: Bool? = nil, futureTo: Bool = false) {
         self.futureVowel = futureVowel
@@ -12,11 +12,19 @@ public class TokenContext {
 }
 
 /// Класс для работы со словарями фонем (эквивалент Python Lexicon)
-public class Lexicon {
+///
+/// Неизменяем после загрузки, поэтому один экземпляр можно использовать
+/// из нескольких потоков одновременно.
+public final class Lexicon: Sendable {
     private let british: Bool
     private let capStresses: (Double, Double) = (0.5, 2.0)
-    private var golds: [String: Any] = [:]
-    private var silvers: [String: Any] = [:]
+    private let golds: LexiconTable
+    private let silvers: LexiconTable
+    /// Слова, произношение которых зависит от POS-тега (в нижнем регистре)
+    private let posSensitiveKeys: Set<String>
+    /// Фонемы слов `Num2Words.Word` по rawValue, найденные один раз при загрузке;
+    /// `nil` - слова нет простой записью в словаре, его ищет `lookup`
+    private let numberWords: [(phonemes: String, rating: Int)?]
     
     // Константы из Python
     private static let diphthongs = Set("AIOQWYʤʧ")
@@ -34,6 +42,7 @@ public class Lexicon {
     ]
     
     private static let ordinals = Set(["st", "nd", "rd", "th"])
+    private static let numberSuffixes = ["ing", "'d", "ed", "'s", "st", "nd", "rd", "th", "s"]
     private static let addSymbols = [".": "dot", "/": "slash"]
     private static let symbols = ["%": "percent", "&": "and", "+": "plus", "@": "at"]
     
@@ -44,10 +53,91 @@ public class Lexicon {
     
     public init(british: Bool, vocabURL: URL) throws {
         self.british = british
-        try loadVocabularies(from: vocabURL)
+        let (golds, silvers) = try Lexicon.loadVocabularies(from: vocabURL, british: british)
+        self.golds = golds
+        self.silvers = silvers
+        self.posSensitiveKeys = Lexicon.posSensitiveKeys(golds: golds, silvers: silvers)
+        self.numberWords = Lexicon.numberWords(golds: golds, silvers: silvers)
+        print("📚 Loaded Lexicon: gold=\(golds.count) entries, silver=\(silvers.count) entries")
+    }
+    
+    /// Инициализация из уже разобранных словарей (для тестов и бенчмарков)
+    init(british: Bool, golds: [String: Any], silvers: [String: Any]) {
+        self.british = british
+        self.golds = LexiconTable(golds)
+        self.silvers = LexiconTable(silvers)
+        self.posSensitiveKeys = Lexicon.posSensitiveKeys(golds: self.golds, silvers: self.silvers)
+        self.numberWords = Lexicon.numberWords(golds: self.golds, silvers: self.silvers)
+    }
+    
+    /// То же, что `lookup(word, nil, nil, TokenContext())` для числительных в нижнем регистре
+    private static func numberWords(golds: LexiconTable, silvers: LexiconTable) -> [(phonemes: String, rating: Int)?] {
+        return Num2Words.Word.allCases.map { word in
+            let text = word.text
+            guard text == text.lowercased() else { return nil }
+            switch (golds[text], silvers[text]) {
+            case (.single(let phonemes)?, _) where !phonemes.isEmpty:
+                return (phonemes, 4)
+            case (nil, .single(let phonemes)?) where !phonemes.isEmpty:
+                return (phonemes, 3)
+            default:
+                return nil
+            }
+        }
+    }
+    
+    /// Фонемы числительного без разбора строки и поиска по словарю
+    func lookup(_ word: Num2Words.Word, stress: Double? = nil) -> (String?, Int?) {
+        guard let entry = numberWords[Int(word.rawValue)] else {
+            return lookup(word.text, tag: nil, stress: stress, context: TokenContext())
+        }
+        return (applyStress(entry.phonemes, stress: stress), entry.rating)
+    }
+    
+    /// Гетеронимы словарей и слова `getSpecialCase`, ветки которых зависят от тега
+    private static func posSensitiveKeys(golds: LexiconTable, silvers: LexiconTable) -> Set<String> {
+        return golds.variantKeys.union(silvers.variantKeys).union(["used", "vs", "am"])
     }
     
-    private func loadVocabularies(from url: URL) throws {
+    /// Может ли POS-тег изменить произношение слова (само слово или его основа без -s/-ed/-ing).
+    ///
+    /// Регистр не учитывается; слова в верхнем регистре и имена собственные
+    /// проверяет вызывающая сторона.
+    func isPOSSensitive(_ word: String) -> Bool {
+        let lowered = word.lowercased()
+        if posSensitiveKeys.contains(lowered) {
+            return true
+        }
+        return Lexicon.stemCandidates(lowered).contains { posSensitiveKeys.contains($0) }
+    }
+    
+    /// Есть ли слово в gold или silver словаре (с регистровыми вариантами)
+    func contains(_ word: String) -> Bool {
+        return golds.contains(word) || silvers.contains(word)
+    }
+    
+    /// Основы, которые проверяют stemS, stemEd и stemIng
+    private static func stemCandidates(_ word: String) -> [String] {
+        var stems: [String] = []
+        if word.hasSuffix("s") {
+            stems.append(String(word.dropLast()))
+            if word.hasSuffix("es") { stems.append(String(word.dropLast(2))) }
+            if word.hasSuffix("ies") { stems.append(String(word.dropLast(3)) + "y") }
+        }
+        if word.hasSuffix("d") {
+            stems.append(String(word.dropLast()))
+            if word.hasSuffix("ed") { stems.append(String(word.dropLast(2))) }
+        }
+        if word.hasSuffix("ing") {
+            let stem = String(word.dropLast(3))
+            stems.append(stem)
+            stems.append(stem + "e")
+            if G2PPatterns.hasDoubledConsonantIng(word) { stems.append(String(stem.dropLast())) }
+        }
+        return stems
+    }
+    
+    private static func loadVocabularies(from url: URL, british: Bool) throws -> (LexiconTable, LexiconTable) {
         // Загружаем gold словарь
         let goldFilename = british ? "en_gb_gold.json" : "en_us_gold.json"
         let goldURL = url.appendingPathComponent(goldFilename)
@@ -59,7 +149,7 @@ public class Lexicon {
         
         let goldData = try Data(contentsOf: goldURL)
         let goldDict = try JSONSerialization.jsonObject(with: goldData) as? [String: Any] ?? [:]
-        self.golds = Lexicon.growDictionary(goldDict)
+        let golds = LexiconTable(goldDict)
         
         // Загружаем silver словарь
         let silverFilename = british ? "en_gb_silver.json" : "en_us_silver.json"
@@ -72,36 +162,16 @@ public class Lexicon {
         
         let silverData = try Data(contentsOf: silverURL)
         let silverDict = try JSONSerialization.jsonObject(with: silverData) as? [String: Any] ?? [:]
-        self.silvers = Lexicon.growDictionary(silverDict)
-        
-        print("📚 Loaded Lexicon: gold=\(golds.count) entries, silver=\(silvers.count) entries")
-    }
-    
-    /// Расширение словаря (как grow_dictionary в Python)
-    private static func growDictionary(_ dict: [String: Any]) -> [String: Any] {
-        var extended: [String: Any] = [:]
-        
-        for (key, value) in dict {
-            if key.count < 2 {
-                continue
-            }
-            
-            if key == key.lowercased() {
-                if key != key.capitalized {
-                    extended[key.capitalized] = value
-                }
-            } else if key == key.lowercased().capitalized {
-                extended[key.lowercased()] = value
-            }
-        }
+        let silvers = LexiconTable(silverDict)
         
-        return extended.merging(dict) { (_, new) in new }
+        // Регистровые варианты (grow_dictionary в Python) LexiconTable разрешает при поиске
+        return (golds, silvers)
     }
     
     /// Получение NNP фонем (как get_NNP в Python)
     private func getNNP(_ word: String) -> (String?, Int?) {
         let phonemes = word.compactMap { char in
-            char.isLetter ? golds[String(char.uppercased())] as? String : nil
+            char.isLetter ? golds[String(char.uppercased())]?.singlePhonemes : nil
         }
         
         if phonemes.isEmpty {
@@ -170,7 +240,7 @@ public class Lexicon {
     
     /// Проверка является ли строка числом
     private static func isDigit(_ text: String) -> Bool {
-        return text.range(of: "^[0-9]+$", options: .regularExpression) != nil
+        return G2PPatterns.isASCIIDigits(text)
     }
     
     /// Получение специальных случаев (как get_special_case в Python)
@@ -190,7 +260,7 @@ public class Lexicon {
             if tag?.hasPrefix("NN") == true {
                 return getNNP(word)
             } else if context.futureVowel == nil || word != "am" || (stress != nil && stress! > 0) {
-                return (golds["am"] as? String, 4)
+                return (golds["am"]?.singlePhonemes, 4)
             }
             return ("ɐm", 4)
         } else if word == "an" || word == "An" || word == "AN" {
@@ -205,7 +275,7 @@ public class Lexicon {
         } else if word == "to" || word == "To" || (word == "TO" && (tag == "TO" || tag == "IN")) {
             let futureVowel = context.futureVowel
             if futureVowel == nil {
-                return (golds["to"] as? String, 4)
+                return (golds["to"]?.singlePhonemes, 4)
             } else if futureVowel == false {
                 return ("tə", 4)
             } else {
@@ -216,16 +286,14 @@ public class Lexicon {
             return ("\(stressStr)ɪn", 4)
         } else if word == "the" || word == "The" || (word == "THE" && tag == "DT") {
             return context.futureVowel == true ? ("ði", 4) : ("ðə", 4)
-        } else if tag == "IN" && word.range(of: "(?i)vs\\.?$", options: .regularExpression) != nil {
+        } else if tag == "IN" && G2PPatterns.endsWithVersus(word) {
             return lookup("versus", tag: nil, stress: nil, context: context)
         } else if word == "used" || word == "Used" || word == "USED" {
-            if (tag == "VBD" || tag == "JJ") && context.futureTo {
-                if let usedDict = golds["used"] as? [String: String] {
-                    return (usedDict["VBD"], 4)
+            if case .variants(let usedVariants)? = golds["used"] {
+                if (tag == "VBD" || tag == "JJ") && context.futureTo {
+                    return (usedVariants["VBD"] ?? nil, 4)
                 }
-            }
-            if let usedDict = golds["used"] as? [String: String] {
-                return (usedDict["DEFAULT"], 4)
+                return (usedVariants["DEFAULT"] ?? nil, 4)
             }
         }
         
@@ -251,13 +319,13 @@ public class Lexicon {
     
     /// Проверка известности слова (как is_known в Python)
     public func isKnown(_ word: String, tag: String?) -> Bool {
-        if golds[word] != nil || Lexicon.symbols[word] != nil || silvers[word] != nil {
+        if golds.contains(word) || Lexicon.symbols[word] != nil || silvers.contains(word) {
             return true
         } else if !word.allSatisfy({ $0.isLetter }) || !word.allSatisfy({ char in Lexicon.lexiconOrds.contains(Int(char.asciiValue ?? 0)) }) {
             return false // TODO: café
         } else if word.count == 1 {
             return true
-        } else if word == word.uppercased() && golds[word.lowercased()] != nil {
+        } else if word == word.uppercased() && golds.contains(word.lowercased()) {
             return true
         }
         
@@ -269,30 +337,38 @@ public class Lexicon {
         var searchWord = word
         var isNNP: Bool? = nil
         
-        if word == word.uppercased() && golds[word] == nil {
+        var entry = golds[word]
+        if word == word.uppercased() && entry == nil {
             searchWord = word.lowercased()
             isNNP = (tag == "NNP")
+            entry = golds[searchWord]
         }
         
-        var phonemes = golds[searchWord]
         var rating = 4
         
-        if phonemes == nil && isNNP != true {
-            phonemes = silvers[searchWord]
+        if entry == nil && isNNP != true {
+            entry = silvers[searchWord]
             rating = 3
         }
         
-        if let dict = phonemes as? [String: Any] {
+        let phonemes: String?
+        switch entry {
+        case .single(let single)?:
+            phonemes = single
+        case .variants(let variants)?:
             var lookupTag = tag
-            if context.futureVowel == nil && dict["None"] != nil {
+            if context.futureVowel == nil && variants.contains("None") {
                 lookupTag = "None"
-            } else if dict[tag ?? ""] == nil {
+            } else if !variants.contains(tag ?? "") {
                 lookupTag = Lexicon.getParentTag(tag)
             }
-            phonemes = dict[lookupTag ?? ""] ?? dict["DEFAULT"]
+            // null-значение варианта (внутренний nil) не откатывается к DEFAULT, как в Python
+            phonemes = (variants[lookupTag ?? ""] ?? variants["DEFAULT"]) ?? nil
+        case nil:
+            phonemes = nil
         }
         
-        if let phonemeStr = phonemes as? String {
+        if let phonemeStr = phonemes {
             if phonemeStr.isEmpty || (isNNP == true && !phonemeStr.contains(Lexicon.primaryStress)) {
                 return getNNP(searchWord)
             }
@@ -449,7 +525,7 @@ public class Lexicon {
         } else if isKnown(String(word.dropLast(3)) + "e", tag: tag) {
             stem = String(word.dropLast(3)) + "e"
         } else if word.count > 5 && 
-                  word.range(of: "([bcdgklmnprstvxz])\\1ing$|cking$", options: .regularExpression) != nil &&
+                  G2PPatterns.hasDoubledConsonantIng(word) &&
                   isKnown(String(word.dropLast(4)), tag: tag) {
             stem = String(word.dropLast(4))
         } else {
@@ -476,15 +552,27 @@ public class Lexicon {
         let lowercased = word.lowercased()
         var searchWord = word
         
+        // Результаты stemming для lowercased запоминаются: если searchWord станет
+        // lowercased, ниже они переиспользуются вместо повторного вызова
+        var stemmed: [(String?, Int?)] = []
+        func stem(_ step: Int) -> (String?, Int?) {
+            while stemmed.count <= step {
+                switch stemmed.count {
+                case 0: stemmed.append(stemS(lowercased, tag: tag, stress: stress, context: context))
+                case 1: stemmed.append(stemEd(lowercased, tag: tag, stress: stress, context: context))
+                default: stemmed.append(stemIng(lowercased, tag: tag, stress: stress ?? 0.5, context: context))
+                }
+            }
+            return stemmed[step]
+        }
+        
         if word.count > 1 && word.replacingOccurrences(of: "'", with: "").allSatisfy({ $0.isLetter }) && 
            word != word.lowercased() && 
            (tag != "NNP" || word.count > 7) &&
-           golds[word] == nil && silvers[word] == nil &&
+           !golds.contains(word) && !silvers.contains(word) &&
            (word == word.uppercased() || word.dropFirst().allSatisfy({ $0.isLowercase })) &&
-           (golds[lowercased] != nil || silvers[lowercased] != nil || 
-            stemS(lowercased, tag: tag, stress: stress, context: context).0 != nil ||
-            stemEd(lowercased, tag: tag, stress: stress, context: context).0 != nil ||
-            stemIng(lowercased, tag: tag, stress: stress, context: context).0 != nil) {
+           (golds.contains(lowercased) || silvers.contains(lowercased) || 
+            stem(0).0 != nil || stem(1).0 != nil || stem(2).0 != nil) {
             searchWord = lowercased
         }
         
@@ -497,6 +585,13 @@ public class Lexicon {
         }
         
         // Проверяем stemming
+        if searchWord == lowercased {
+            for step in 0..<3 where stem(step).0 != nil {
+                return stem(step)
+            }
+            return (nil, nil)
+        }
+        
         let (sPhonemes, sRating) = stemS(searchWord, tag: tag, stress: stress, context: context)
         if sPhonemes != nil {
             return (sPhonemes, sRating)
@@ -522,16 +617,15 @@ public class Lexicon {
             return phonemes
         }
         
-        let currencyPhonemes = appendS(currencyInfo.0 + "s")
+        // self.stem_s(CURRENCIES[currency][0]+'s') - как и в get_number, по фонемам единицы
+        let currencyPhonemes = stemS(currencyInfo.0 + "s", tag: nil, stress: nil, context: TokenContext()).0
         return currencyPhonemes != nil ? "\(phonemes) \(currencyPhonemes!)" : phonemes
     }
     
     /// Обработка чисел (как get_number в Python)
     private func getNumber(_ word: String, currency: String?, isHead: Bool, numFlags: String) -> (String?, Int?) {
         // suffix = re.search(r"[a-z']+$", word)
-        let suffixRegex = try! NSRegularExpression(pattern: "[a-z']+$")
-        let suffixMatch = suffixRegex.firstMatch(in: word, range: NSRange(word.startIndex..., in: word))
-        let suffix: String? = suffixMatch.flatMap { Range($0.range, in: word) }.map { String(word[$0]) }
+        let suffix: String? = G2PPatterns.lowercaseSuffix(word).map { String($0) }
         
         // word = word[:-len(suffix)] if suffix else word
         var processWord = word
@@ -543,35 +637,26 @@ public class Lexicon {
         
         // if word.startswith('-'): result.append(self.lookup('minus', None, None, None)); word = word[1:]
         if processWord.hasPrefix("-") {
-            result.append(lookup("minus", tag: nil, stress: nil, context: TokenContext()))
+            result.append(lookup(.minus))
             processWord = String(processWord.dropFirst())
         }
         
-        // def extend_num(num, first=True, escape=False):
-        func extendNum(_ num: String, first: Bool = true, escape: Bool = false) {
-            let numStr: String
-            if escape {
-                numStr = num
-            } else if let intNum = Int(num) {
-                numStr = Num2Words.convert(intNum, to: "cardinal")
-            } else {
-                numStr = num
-            }
-            
-            // splits = re.split(r'[^a-z]+', num if escape else num2words(int(num)))
-            let splits = numStr.components(separatedBy: CharacterSet.letters.inverted).filter { !$0.isEmpty }
-            
-            for (i, w) in splits.enumerated() {
+        // Слова num2words пишутся в один буфер, фонемы берутся из таблицы numberWords
+        var words: [Num2Words.Word] = []
+        words.reserveCapacity(16)
+        
+        // def extend_num(num, first=True, escape=False): для escape - уже готовые слова
+        func extendWords(first: Bool = true) {
+            for (i, w) in words.enumerated() {
                 // if w != 'and' or '&' in num_flags:
-                if w != "and" || numFlags.contains("&") {
+                if w != .and || numFlags.contains("&") {
                     // if first and i == 0 and len(splits) > 1 and w == 'one' and 'a' in num_flags:
-                    if first && i == 0 && splits.count > 1 && w == "one" && numFlags.contains("a") {
+                    if first && i == 0 && words.count > 1 && w == .one && numFlags.contains("a") {
                         result.append(("ə", 4))
                     } else {
-                        let stress: Double? = (w == "point") ? -2 : nil
-                        result.append(lookup(w, tag: nil, stress: stress, context: TokenContext()))
+                        result.append(lookup(w, stress: w == .point ? -2 : nil))
                     }
-                } else if w == "and" && numFlags.contains("n") && !result.isEmpty {
+                } else if numFlags.contains("n") && !result.isEmpty {
                     // elif w == 'and' and 'n' in num_flags and result:
                     //     result[-1] = (result[-1][0] + 'ən', result[-1][1])
                     if let last = result.last, let phonemes = last.0 {
@@ -579,13 +664,21 @@ public class Lexicon {
                     }
                 }
             }
+            words.removeAll(keepingCapacity: true)
+        }
+        
+        func extendNum<Digits: StringProtocol>(_ num: Digits, first: Bool = true) {
+            if let intNum = Int(num) {
+                Num2Words.cardinal(intNum, into: &words)
+            }
+            extendWords(first: first)
         }
         
         // if is_digit(word) and suffix in ORDINALS:
         if Lexicon.isDigit(processWord) && suffix != nil && Lexicon.ordinals.contains(suffix!) {
             if let intWord = Int(processWord) {
-                let ordinalStr = Num2Words.convert(intWord, to: "ordinal")
-                extendNum(ordinalStr, escape: true)
+                Num2Words.ordinal(intWord, into: &words)
+                extendWords()
             }
         }
         // elif not result and len(word) == 4 and currency not in CURRENCIES and is_digit(word):
@@ -593,8 +686,8 @@ public class Lexicon {
                 (currency == nil || !Lexicon.currencies.keys.contains(currency!)) && 
                 Lexicon.isDigit(processWord) {
             if let intWord = Int(processWord) {
-                let yearStr = Num2Words.convert(intWord, to: "year")
-                extendNum(yearStr, escape: true)
+                Num2Words.year(intWord, into: &words)
+                extendWords()
             }
         }
         // elif not is_head and '.' not in word:
@@ -602,16 +695,15 @@ public class Lexicon {
             let num = processWord.replacingOccurrences(of: ",", with: "")
             if num.first == "0" || num.count > 3 {
                 // [extend_num(n, first=False) for n in num]
-                for char in num {
-                    extendNum(String(char), first: false)
-                }
+                Num2Words.digits(num, into: &words)
+                extendWords(first: false)
             } else if num.count == 3 && !num.hasSuffix("00") {
-                extendNum(String(num.first!))
+                extendNum(num.prefix(1))
                 if num.dropFirst().first == "0" {
                     result.append(lookup("O", tag: nil, stress: -2, context: TokenContext()))
-                    extendNum(String(num.suffix(1)), first: false)
+                    extendNum(num.suffix(1), first: false)
                 } else {
-                    extendNum(String(num.suffix(2)), first: false)
+                    extendNum(num.suffix(2), first: false)
                 }
             } else {
                 extendNum(num)
@@ -624,9 +716,8 @@ public class Lexicon {
                 if num.isEmpty {
                     continue
                 } else if num.first == "0" || (num.count != 2 && num.dropFirst().contains { $0 != "0" }) {
-                    for char in num {
-                        extendNum(String(char), first: false)
-                    }
+                    Num2Words.digits(num, into: &words)
+                    extendWords(first: false)
                 } else {
                     extendNum(num, first: first)
                 }
@@ -658,18 +749,14 @@ public class Lexicon {
             
             for (i, (num, unit)) in pairs.enumerated() {
                 if i > 0 {
-                    result.append(lookup("and", tag: nil, stress: nil, context: TokenContext()))
+                    result.append(lookup(.and))
                 }
-                extendNum(String(num), first: i == 0)
+                Num2Words.cardinal(num, into: &words)
+                extendWords(first: i == 0)
                 
-                let finalUnit: String
+                // self.stem_s(unit+'s') - окончание добавляется к фонемам единицы, а не к ее написанию
                 if abs(num) != 1 && unit != "pence" {
-                    finalUnit = unit + "s"
-                    if let stemmed = appendS(unit) {
-                        result.append((stemmed, 4))  // Используем stemmed версию
-                    } else {
-                        result.append(lookup(finalUnit, tag: nil, stress: nil, context: TokenContext()))
-                    }
+                    result.append(stemS(unit + "s", tag: nil, stress: nil, context: TokenContext()))
                 } else {
                     result.append(lookup(unit, tag: nil, stress: nil, context: TokenContext()))
                 }
@@ -679,29 +766,27 @@ public class Lexicon {
         else {
             if Lexicon.isDigit(processWord) {
                 if let intWord = Int(processWord) {
-                    let cardinalStr = Num2Words.convert(intWord, to: "cardinal")
-                    extendNum(cardinalStr, escape: true)
+                    Num2Words.cardinal(intWord, into: &words)
+                    extendWords()
                 }
             } else if !processWord.contains(".") {
                 let cleanNum = processWord.replacingOccurrences(of: ",", with: "")
                 if let intNum = Int(cleanNum) {
-                    let type = (suffix != nil && Lexicon.ordinals.contains(suffix!)) ? "ordinal" : "cardinal"
-                    let numStr = Num2Words.convert(intNum, to: type)
-                    extendNum(numStr, escape: true)
+                    if suffix != nil && Lexicon.ordinals.contains(suffix!) {
+                        Num2Words.ordinal(intNum, into: &words)
+                    } else {
+                        Num2Words.cardinal(intNum, into: &words)
+                    }
+                    extendWords()
                 }
             } else {
                 let cleanNum = processWord.replacingOccurrences(of: ",", with: "")
                 if cleanNum.hasPrefix(".") {
-                    var pointStr = "point"
-                    for char in cleanNum.dropFirst() {
-                        if let digit = Int(String(char)) {
-                            pointStr += " " + Num2Words.convert(digit)
-                        }
-                    }
-                    extendNum(pointStr, escape: true)
-                } else if let floatNum = Double(cleanNum) {
-                    let floatStr = Num2Words.convert(floatNum)
-                    extendNum(floatStr, escape: true)
+                    words.append(.point)
+                    Num2Words.digits(cleanNum.dropFirst(), into: &words)
+                    extendWords()
+                } else if Num2Words.decimal(cleanNum, into: &words) {
+                    extendWords()
                 }
             }
         }
@@ -746,10 +831,9 @@ public class Lexicon {
             return false
         }
         
-        let suffixes = ["ing", "'d", "ed", "'s"] + Array(Lexicon.ordinals) + ["s"]
         var checkWord = word
         
-        for suffix in suffixes {
+        for suffix in Lexicon.numberSuffixes {
             if word.hasSuffix(suffix) {
                 checkWord = String(word.dropLast(suffix.count))
                 break
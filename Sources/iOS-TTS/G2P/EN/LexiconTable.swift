@@ -0,0 +1,235 @@
+import Foundation
+
+/// Компактное неизменяемое представление словаря фонем (gold или silver).
+///
+/// Ключи хранятся подряд в одном UTF-8 буфере, индекс - открытая адресация
+/// с регистронезависимым хешем по байтам. Благодаря этому регистровые
+/// варианты из `grow_dictionary` не хранятся отдельно, а находятся тем же
+/// пробингом, что и точное совпадение. Одинаковые строки фонем интернируются.
+struct LexiconTable: Sendable {
+
+    /// Запись словаря: одно произношение или набор вариантов по POS-тегу
+    enum Entry: Sendable, Equatable {
+        case single(String)
+        case variants(POSVariants)
+
+        /// Фонемы записи, если она не зависит от тега
+        var singlePhonemes: String? {
+            if case .single(let phonemes) = self {
+                return phonemes
+            }
+            return nil
+        }
+    }
+
+    /// Варианты произношения гетеронима (ключи - POS-теги, "DEFAULT", "None")
+    struct POSVariants: Sendable, Equatable {
+        fileprivate let tags: [String]
+        fileprivate let phonemes: [String?]
+
+        func contains(_ tag: String) -> Bool {
+            return tags.contains(tag)
+        }
+
+        /// Внешний nil - тега нет, внутренний nil - тег есть, но значение null
+        subscript(tag: String) -> String?? {
+            guard let index = tags.firstIndex(of: tag) else { return nil }
+            return .some(phonemes[index])
+        }
+    }
+
+    private let keyBytes: [UInt8]
+    private let keyStarts: [Int32]
+    private let entries: [Entry]
+    private let slots: [Int32]
+    private let slotMask: Int
+
+    /// Количество исходных ключей (без регистровых вариантов)
+    var count: Int { entries.count }
+
+    /// Построение из JSON-словаря вида `{word: "phonemes" | {tag: "phonemes" | null}}`.
+    /// Значения других типов отбрасываются.
+    init(_ dict: [String: Any]) {
+        var interned: [String: String] = [:]
+        func intern(_ phonemes: String) -> String {
+            if let existing = interned[phonemes] {
+                return existing
+            }
+            interned[phonemes] = phonemes
+            return phonemes
+        }
+
+        var keyBytes: [UInt8] = []
+        var keyStarts: [Int32] = [0]
+        var entries: [Entry] = []
+        keyStarts.reserveCapacity(dict.count + 1)
+        entries.reserveCapacity(dict.count)
+
+        for (key, value) in dict {
+            let entry: Entry
+            if let phonemes = value as? String {
+                entry = .single(intern(phonemes))
+            } else if let variants = value as? [String: Any] {
+                let tags = variants.keys.sorted()
+                let phonemes = tags.map { tag in (variants[tag] as? String).map(intern) }
+                entry = .variants(POSVariants(tags: tags, phonemes: phonemes))
+            } else {
+                continue
+            }
+            keyBytes.append(contentsOf: key.utf8)
+            keyStarts.append(Int32(keyBytes.count))
+            entries.append(entry)
+        }
+
+        // Заполненность таблицы не выше 50%
+        var capacity = 16
+        while capacity < entries.count * 2 {
+            capacity <<= 1
+        }
+        var slots = [Int32](repeating: -1, count: capacity)
+        let mask = capacity - 1
+
+        keyBytes.withUnsafeBufferPointer { bytes in
+            for index in 0..<entries.count {
+                let start = Int(keyStarts[index])
+                let end = Int(keyStarts[index + 1])
+                let key = UnsafeBufferPointer(rebasing: bytes[start..<end])
+                var slot = Int(truncatingIfNeeded: LexiconTable.foldedHash(key)) & mask
+                while slots[slot] >= 0 {
+                    slot = (slot + 1) & mask
+                }
+                slots[slot] = Int32(index)
+            }
+        }
+
+        self.keyBytes = keyBytes
+        self.keyStarts = keyStarts
+        self.entries = entries
+        self.slots = slots
+        self.slotMask = mask
+    }
+
+    /// Поиск записи с учетом регистровых вариантов (как после grow_dictionary)
+    subscript(word: String) -> Entry? {
+        var word = word
+        let (exact, caseVariants) = word.withUTF8 { probe($0) }
+        if let exact = exact {
+            return entries[exact]
+        }
+
+        for index in caseVariants where LexiconTable.isCaseVariant(key(at: index), of: word) {
+            return entries[index]
+        }
+
+        // Регистр не-ASCII символов хеш не сворачивает - проверяем варианты явно
+        if caseVariants.isEmpty && word.utf8.contains(where: { $0 >= 0x80 }) {
+            for candidate in [word.lowercased(), word.capitalized] where candidate != word {
+                var candidate = candidate
+                if let index = candidate.withUTF8({ probe($0).exact }),
+                   LexiconTable.isCaseVariant(key(at: index), of: word) {
+                    return entries[index]
+                }
+            }
+        }
+
+        return nil
+    }
+
+    func contains(_ word: String) -> Bool {
+        return self[word] != nil
+    }
+
+    /// Ключи записей с вариантами по POS-тегу (гетеронимы) в нижнем регистре
+    var variantKeys: Set<String> {
+        var keys = Set<String>()
+        for (index, entry) in entries.enumerated() {
+            if case .variants = entry {
+                keys.insert(key(at: index).lowercased())
+            }
+        }
+        return keys
+    }
+
+    /// Приблизительный объем памяти под ключи, индекс и записи (без строк фонем)
+    var indexBytes: Int {
+        return keyBytes.count
+            + keyStarts.count * MemoryLayout<Int32>.stride
+            + slots.count * MemoryLayout<Int32>.stride
+            + entries.count * MemoryLayout<Entry>.stride
+    }
+
+    // MARK: - Private
+
+    private func key(at index: Int) -> String {
+        let start = Int(keyStarts[index])
+        let end = Int(keyStarts[index + 1])
+        return String(decoding: keyBytes[start..<end], as: UTF8.self)
+    }
+
+    /// Пробинг: точное совпадение и ключи, равные запросу без учета ASCII-регистра
+    private func probe(_ query: UnsafeBufferPointer<UInt8>) -> (exact: Int?, caseVariants: [Int]) {
+        var caseVariants: [Int] = []
+        var slot = Int(truncatingIfNeeded: LexiconTable.foldedHash(query)) & slotMask
+
+        return keyBytes.withUnsafeBufferPointer { bytes in
+            while true {
+                let index = Int(slots[slot])
+                if index < 0 {
+                    return (nil, caseVariants)
+                }
+
+                let start = Int(keyStarts[index])
+                let end = Int(keyStarts[index + 1])
+                if end - start == query.count {
+                    var exact = true
+                    var folded = true
+                    for i in 0..<query.count {
+                        let a = bytes[start + i]
+                        let b = query[i]
+                        if a != b {
+                            exact = false
+                            if LexiconTable.foldASCII(a) != LexiconTable.foldASCII(b) {
+                                folded = false
+                                break
+                            }
+                        }
+                    }
+                    if exact {
+                        return (index, caseVariants)
+                    } else if folded {
+                        caseVariants.append(index)
+                    }
+                }
+                slot = (slot + 1) & slotMask
+            }
+        }
+    }
+
+    /// Правила grow_dictionary: "word" -> "Word" и "Word" -> "word"
+    private static func isCaseVariant(_ key: String, of word: String) -> Bool {
+        guard key.count >= 2 else { return false }
+
+        let lowercased = key.lowercased()
+        if key == lowercased {
+            return key != key.capitalized && key.capitalized == word
+        } else if key == lowercased.capitalized {
+            return lowercased == word
+        }
+        return false
+    }
+
+    @inline(__always)
+    private static func foldASCII(_ byte: UInt8) -> UInt8 {
+        return (byte >= 0x41 && byte <= 0x5A) ? byte | 0x20 : byte
+    }
+
+    /// FNV-1a по байтам с приведением ASCII к нижнему регистру
+    private static func foldedHash(_ bytes: UnsafeBufferPointer<UInt8>) -> UInt64 {
+        var hash: UInt64 = 0xcbf29ce484222325
+        for byte in bytes {
+            hash ^= UInt64(foldASCII(byte))
+            hash = hash &* 0x100000001b3
+        }
+        return hash
+    }
+}
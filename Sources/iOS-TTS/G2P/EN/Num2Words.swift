@@ -1,167 +1,164 @@
 import Foundation
 
 /// Swift реализация num2words для английского языка
-public class Num2Words {
-    
-    // Базовые числительные
-    private static let lowNumbers = [
-        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
-        "ten", "eleven", "twelve", "thirteen", "fourteen", "fifteen", "sixteen", "seventeen", "eighteen", "nineteen"
-    ]
-    
-    private static let tens = [
-        "", "", "twenty", "thirty", "forty", "fifty", "sixty", "seventy", "eighty", "ninety"
-    ]
-    
-    private static let ordinals = [
-        "first", "second", "third", "fourth", "fifth", "sixth", "seventh", "eighth", "ninth", "tenth",
-        "eleventh", "twelfth", "thirteenth", "fourteenth", "fifteenth", "sixteenth", "seventeenth", "eighteenth", "nineteenth", "twentieth"
-    ]
-    
-    private static let ordinalSuffixes: [String: String] = [
-        "one": "first", "two": "second", "three": "third", "four": "fourth", "five": "fifth",
-        "six": "sixth", "seven": "seventh", "eight": "eighth", "nine": "ninth", "ten": "tenth",
-        "eleven": "eleventh", "twelve": "twelfth"
-    ]
-    
-    /// Конвертация числа в кардинальное числительное
-    public static func cardinal(_ number: Int) -> String {
-        if number < 0 {
-            return "minus " + cardinal(abs(number))
+///
+/// Числа раскладываются в последовательность `Word` во внешний буфер без
+/// промежуточных строк; `Lexicon` сопоставляет слова с заранее найденными
+/// фонемами. Строковые методы оставлены для совместимости и собирают текст из тех же слов.
+public enum Num2Words {
+
+    /// Словарь числительных - все слова, которые может выдать num2words
+    public enum Word: UInt8, CaseIterable, Comparable, Sendable {
+        case zero, one, two, three, four, five, six, seven, eight, nine
+        case ten, eleven, twelve, thirteen, fourteen, fifteen, sixteen, seventeen, eighteen, nineteen
+        case twenty, thirty, forty, fifty, sixty, seventy, eighty, ninety
+        case hundred, thousand, million, billion
+        case zeroth, first, second, third, fourth, fifth, sixth, seventh, eighth, ninth
+        case tenth, eleventh, twelfth, thirteenth, fourteenth, fifteenth, sixteenth, seventeenth, eighteenth, nineteenth
+        case twentieth, thirtieth, fortieth, fiftieth, sixtieth, seventieth, eightieth, ninetieth
+        case hundredth, thousandth, millionth, billionth
+        case and, point, minus, oh, bc
+
+        public static func < (lhs: Word, rhs: Word) -> Bool {
+            return lhs.rawValue < rhs.rawValue
         }
-        
-        if number < 20 {
-            return lowNumbers[number]
-        } else if number < 100 {
-            let ten = number / 10
-            let unit = number % 10
-            if unit == 0 {
-                return tens[ten]
-            } else {
-                return tens[ten] + "-" + lowNumbers[unit]
-            }
-        } else if number < 1000 {
-            let hundred = number / 100
-            let remainder = number % 100
-            var result = lowNumbers[hundred] + " hundred"
-            if remainder != 0 {
-                result += " and " + cardinal(remainder)
-            }
-            return result
-        } else if number < 1000000 {
-            let thousand = number / 1000
-            let remainder = number % 1000
-            var result = cardinal(thousand) + " thousand"
-            if remainder != 0 {
-                result += remainder < 100 ? " and " + cardinal(remainder) : ", " + cardinal(remainder)
-            }
-            return result
-        } else if number < 1000000000 {
-            let million = number / 1000000
-            let remainder = number % 1000000
-            var result = cardinal(million) + " million"
-            if remainder != 0 {
-                result += remainder < 100 ? " and " + cardinal(remainder) : ", " + cardinal(remainder)
-            }
-            return result
-        } else {
-            let billion = number / 1000000000
-            let remainder = number % 1000000000
-            var result = cardinal(billion) + " billion"
-            if remainder != 0 {
-                result += remainder < 100 ? " and " + cardinal(remainder) : ", " + cardinal(remainder)
+
+        public var text: String {
+            return Word.texts[Int(rawValue)]
+        }
+
+        private static let texts: [String] = Word.allCases.map { word in
+            word == .bc ? "BC" : String(describing: word)
+        }
+
+        /// Порядковая форма последнего слова ("twenty" -> "twentieth")
+        fileprivate var ordinal: Word {
+            switch self {
+            case .zero...(.nineteen):
+                return Word(rawValue: rawValue - Word.zero.rawValue + Word.zeroth.rawValue)!
+            case .twenty...(.billion):
+                return Word(rawValue: rawValue - Word.twenty.rawValue + Word.twentieth.rawValue)!
+            default:
+                return self
             }
-            return result
+        }
+
+        fileprivate var isTens: Bool {
+            return (Word.twenty...Word.ninety).contains(self)
+        }
+
+        fileprivate var isUnit: Bool {
+            return (Word.one...Word.nine).contains(self) || (Word.first...Word.ninth).contains(self)
         }
     }
-    
-    /// Конвертация числа в порядковое числительное
-    public static func ordinal(_ number: Int) -> String {
+
+    // MARK: - Word buffers
+
+    /// Кардинальное числительное
+    public static func cardinal(_ number: Int, into words: inout [Word]) {
         if number < 0 {
-            return "minus " + ordinal(abs(number))
-        }
-        
-        if number < ordinals.count {
-            return ordinals[number - 1]  // ordinals array is 0-indexed but starts from "first"
-        }
-        
-        let cardinalStr = cardinal(number)
-        let words = cardinalStr.components(separatedBy: " ")
-        var lastWords = words.last?.components(separatedBy: "-") ?? []
-        let lastWord = lastWords.last?.lowercased() ?? ""
-        
-        if let ordinalForm = ordinalSuffixes[lastWord] {
-            lastWords[lastWords.count - 1] = ordinalForm
-        } else {
-            var ordinalWord = lastWord
-            if ordinalWord.hasSuffix("y") {
-                ordinalWord = String(ordinalWord.dropLast()) + "ie"
-            }
-            ordinalWord += "th"
-            lastWords[lastWords.count - 1] = ordinalWord
+            words.append(.minus)
         }
-        
-        var result = words
-        result[result.count - 1] = lastWords.joined(separator: "-")
-        return result.joined(separator: " ")
+        appendCardinal(number.magnitude, into: &words)
     }
-    
-    /// Конвертация года в слова
-    public static func year(_ number: Int) -> String {
+
+    /// Порядковое числительное: кардинальное с порядковым последним словом
+    public static func ordinal(_ number: Int, into words: inout [Word]) {
+        cardinal(number, into: &words)
+        words[words.count - 1] = words[words.count - 1].ordinal
+    }
+
+    /// Год: "nineteen oh five", "nineteen hundred", "two thousand and five"
+    public static func year(_ number: Int, into words: inout [Word]) {
         if number < 0 {
-            return cardinal(abs(number)) + " BC"
+            cardinal(-number, into: &words)
+            words.append(.bc)
+            return
         }
-        
         if number < 100 || number >= 10000 {
-            return cardinal(number)
+            cardinal(number, into: &words)
+            return
         }
-        
+
         let high = number / 100
         let low = number % 100
-        
-        // Если год вида X000, X00X или просто большой - используем кардинальные
-        if (high % 10 == 0 && low < 10) {
-            return cardinal(number)
-        }
-        
-        if low == 0 {
-            return cardinal(high) + " hundred"
+
+        // Годы вида X000 и X00X читаются как обычные числа
+        if high % 10 == 0 && low < 10 {
+            cardinal(number, into: &words)
+        } else if low == 0 {
+            cardinal(high, into: &words)
+            words.append(.hundred)
         } else if low < 10 {
-            return cardinal(high) + " oh " + lowNumbers[low]
+            cardinal(high, into: &words)
+            words.append(.oh)
+            words.append(unit(low))
         } else {
-            return cardinal(high) + " " + cardinal(low)
+            cardinal(high, into: &words)
+            cardinal(low, into: &words)
         }
     }
-    
-    /// Конвертация десятичного числа в слова
-    public static func float(_ number: Double) -> String {
-        let integerPart = Int(number)
-        let fractionalPart = number - Double(integerPart)
-        
-        if fractionalPart == 0 {
-            return cardinal(integerPart)
-        }
-        
-        var result = cardinal(integerPart) + " point"
-        
-        // Конвертируем дробную часть в строку и обрабатываем каждую цифру
-        let fractionalStr = String(format: "%.10f", fractionalPart).dropFirst(2) // убираем "0."
-        let trimmed = fractionalStr.trimmingCharacters(in: CharacterSet(charactersIn: "0")) // убираем trailing zeros
-        
-        for char in trimmed {
-            if let digit = Int(String(char)) {
-                result += " " + lowNumbers[digit]
+
+    /// Десятичная запись "12.05": целая часть и цифры дроби без хвостовых нулей.
+    /// - Returns: `false`, если строка не является десятичным числом
+    @discardableResult
+    public static func decimal(_ text: String, into words: inout [Word]) -> Bool {
+        let parts = text.split(separator: ".", maxSplits: 1, omittingEmptySubsequences: false)
+        guard let integerPart = parts.first, parts.count <= 2 else { return false }
+
+        let isNegative = integerPart.hasPrefix("-")
+        let integerDigits = integerPart.dropFirst(isNegative ? 1 : 0).utf8
+        var fraction = parts.count == 2 ? parts[1].utf8 : Substring().utf8
+        guard integerDigits.allSatisfy(isDigit), fraction.allSatisfy(isDigit) else { return false }
+        while fraction.last == UInt8(ascii: "0") {
+            fraction = fraction.dropLast()
+        }
+
+        if isNegative {
+            words.append(.minus)
+        }
+        appendCardinal(digits: integerDigits, into: &words)
+        if !fraction.isEmpty {
+            words.append(.point)
+            for digit in fraction {
+                words.append(unit(Int(digit - UInt8(ascii: "0"))))
             }
         }
-        
-        return result
+        return true
+    }
+
+    /// Цифры по одной (номера телефонов и т.д.), нецифровые символы пропускаются
+    public static func digits<Digits: StringProtocol>(_ text: Digits, into words: inout [Word]) {
+        for byte in text.utf8 where byte >= UInt8(ascii: "0") && byte <= UInt8(ascii: "9") {
+            words.append(unit(Int(byte - UInt8(ascii: "0"))))
+        }
+    }
+
+    // MARK: - Strings
+
+    /// Конвертация числа в кардинальное числительное
+    public static func cardinal(_ number: Int) -> String {
+        return render { cardinal(number, into: &$0) }
+    }
+
+    /// Конвертация числа в порядковое числительное
+    public static func ordinal(_ number: Int) -> String {
+        return render { ordinal(number, into: &$0) }
+    }
+
+    /// Конвертация года в слова
+    public static func year(_ number: Int) -> String {
+        return render { year(number, into: &$0) }
     }
-    
+
+    /// Конвертация десятичного числа в слова
+    public static func float(_ number: Double) -> String {
+        return render { _ = decimal(plainDecimal(number), into: &$0) }
+    }
+
     /// Основной интерфейс, аналогичный Python num2words
     public static func convert(_ number: Int, to type: String = "cardinal") -> String {
         switch type {
-        case "cardinal":
-            return cardinal(number)
         case "ordinal":
             return ordinal(number)
         case "year":
@@ -170,19 +167,112 @@ public class Num2Words {
             return cardinal(number)
         }
     }
-    
+
     /// Перегрузка для Float
     public static func convert(_ number: Double) -> String {
         return float(number)
     }
-    
+
     /// Конвертация отдельных цифр в слова (для номеров телефонов и т.д.)
     public static func digits(_ number: String) -> String {
-        return number.compactMap { char in
-            if let digit = Int(String(char)) {
-                return lowNumbers[digit]
+        return render { digits(number, into: &$0) }
+    }
+
+    // MARK: - Private
+
+    private static func unit(_ digit: Int) -> Word {
+        return Word(rawValue: UInt8(digit))!
+    }
+
+    private static let scales: [(value: UInt, word: Word)] = [
+        (1_000_000_000, .billion), (1_000_000, .million), (1_000, .thousand)
+    ]
+
+    private static func appendCardinal(_ number: UInt, into words: inout [Word]) {
+        if number < 20 {
+            words.append(Word(rawValue: UInt8(number))!)
+        } else if number < 100 {
+            words.append(Word(rawValue: Word.twenty.rawValue + UInt8(number / 10 - 2))!)
+            if number % 10 != 0 {
+                words.append(unit(Int(number % 10)))
+            }
+        } else if number < 1000 {
+            words.append(unit(Int(number / 100)))
+            words.append(.hundred)
+            if number % 100 != 0 {
+                words.append(.and)
+                appendCardinal(number % 100, into: &words)
+            }
+        } else {
+            let scale = scales.first { number >= $0.value }!
+            appendCardinal(number / scale.value, into: &words)
+            words.append(scale.word)
+            let remainder = number % scale.value
+            if remainder != 0 {
+                if remainder < 100 {
+                    words.append(.and)
+                }
+                appendCardinal(remainder, into: &words)
+            }
+        }
+    }
+
+    /// Целое любой длины цифрами: больше `UInt` - через "billion", как `appendCardinal`
+    private static func appendCardinal(digits: Substring.UTF8View, into words: inout [Word]) {
+        let digits = digits.drop { $0 == UInt8(ascii: "0") }
+        guard digits.count > 18 else {
+            appendCardinal(digits.reduce(UInt(0)) { $0 * 10 + UInt($1 - UInt8(ascii: "0")) }, into: &words)
+            return
+        }
+        let low = digits.suffix(9).reduce(UInt(0)) { $0 * 10 + UInt($1 - UInt8(ascii: "0")) }
+        appendCardinal(digits: digits.dropLast(9), into: &words)
+        words.append(.billion)
+        if low != 0 {
+            if low < 100 {
+                words.append(.and)
             }
-            return nil
-        }.joined(separator: " ")
+            appendCardinal(low, into: &words)
+        }
+    }
+
+    /// Кратчайшая запись `Double` без экспоненты: 1e-05 -> "0.00001", 1e+20 -> "100000000000000000000"
+    private static func plainDecimal(_ number: Double) -> String {
+        let text = String(number)
+        guard let e = text.firstIndex(where: { $0 == "e" || $0 == "E" }),
+              let exponent = Int(text[text.index(after: e)...]) else {
+            return text
+        }
+        var mantissa = text[..<e]
+        let sign = mantissa.hasPrefix("-") ? "-" : ""
+        mantissa = mantissa.drop { $0 == "-" }
+        let parts = mantissa.split(separator: ".", maxSplits: 1, omittingEmptySubsequences: false)
+        let digits = parts.joined()
+        let point = parts[0].count + exponent
+        if point <= 0 {
+            return sign + "0." + String(repeating: "0", count: -point) + digits
+        }
+        if point >= digits.count {
+            return sign + digits + String(repeating: "0", count: point - digits.count)
+        }
+        return sign + String(digits.prefix(point)) + "." + String(digits.dropFirst(point))
+    }
+
+    @inline(__always)
+    private static func isDigit(_ byte: UInt8) -> Bool {
+        return byte >= UInt8(ascii: "0") && byte <= UInt8(ascii: "9")
+    }
+
+    /// Текст из слов: десятки и единицы через дефис, остальное через пробел
+    private static func render(_ build: (inout [Word]) -> Void) -> String {
+        var words: [Word] = []
+        build(&words)
+        var result = ""
+        for (i, word) in words.enumerated() {
+            if i > 0 {
+                result += words[i - 1].isTens && word.isUnit ? "-" : " "
+            }
+            result += word.text
+        }
+        return result
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,72 @@
+import Foundation
+
+/// Упаковка предложений в общие вызовы POS-теггера и раскладка тегов обратно.
+///
+/// `SwiftPOSTagger` принимает только одну строку, поэтому батч - это несколько
+/// предложений, склеенных через пробел, в пределах бюджета символов. Теги
+/// раскладываются по предложениям сопоставлением символов токенов (без пробелов)
+/// с текстом каждого предложения; при любом расхождении батч не используется.
+enum POSTagBatcher {
+
+    /// Бюджет символов на один вызов - с запасом под длину входа модели теггера
+    static let maxBatchCharacters = 512
+    static let maxBatchSentences = 16
+
+    /// Диапазоны индексов предложений, которые тегируются одним вызовом
+    static func pack(_ texts: [String], maxCharacters: Int = maxBatchCharacters, maxSentences: Int = maxBatchSentences) -> [Range<Int>] {
+        var batches: [Range<Int>] = []
+        var start = 0
+        var characters = 0
+        for (index, text) in texts.enumerated() {
+            let length = text.utf8.count + 1
+            if index > start && (characters + length > maxCharacters || index - start >= maxSentences) {
+                batches.append(start..<index)
+                start = index
+                characters = 0
+            }
+            characters += length
+        }
+        if start < texts.count {
+            batches.append(start..<texts.count)
+        }
+        return batches
+    }
+
+    /// Текст одного вызова теггера для батча
+    static func join(_ texts: ArraySlice<String>) -> String {
+        return texts.joined(separator: " ")
+    }
+
+    /// Раскладывает пары (токен, тег) общего вызова по предложениям.
+    /// - Returns: Пары каждого предложения или `nil`, если токены не совпали с текстом
+    static func scatter(_ pairs: [(String, String)], over texts: ArraySlice<String>) -> [[(String, String)]]? {
+        var result: [[(String, String)]] = []
+        result.reserveCapacity(texts.count)
+        var position = 0
+
+        for text in texts {
+            let expected = significantScalars(text)
+            var consumed = 0
+            var sentencePairs: [(String, String)] = []
+
+            while consumed < expected.count {
+                guard position < pairs.count else { return nil }
+                let scalars = significantScalars(pairs[position].0)
+                let end = consumed + scalars.count
+                guard end <= expected.count, expected[consumed..<end].elementsEqual(scalars) else {
+                    return nil
+                }
+                sentencePairs.append(pairs[position])
+                consumed = end
+                position += 1
+            }
+            result.append(sentencePairs)
+        }
+        return position == pairs.count ? result : nil
+    }
+
+    /// Скаляры без пробелов и без учета регистра - теггер может нормализовать токены
+    private static func significantScalars(_ text: String) -> [Unicode.Scalar] {
+        return text.lowercased().unicodeScalars.filter { !$0.properties.isWhitespace }
+    }
+}
@@ -0,0 +1,183 @@
+import Foundation
+
+/// Дешевый теггер по правилам для предложений без POS-зависимых слов.
+///
+/// Токенизирует как базовый токенизатор BERT в `SwiftPOSTagger` (пробелы, каждый
+/// знак пунктуации - отдельный токен) и проставляет только те теги, от которых
+/// зависит G2P: пунктуация, `$`, `CD`, `DT`/`TO`/`IN`/`PRP` для служебных слов
+/// и `NNP` для имен собственных. Если в предложении есть слово, произношение
+/// которого может зависеть от тега, возвращает `nil` - нужен настоящий теггер.
+enum RuleBasedTagger {
+
+    static func tag(_ text: String, lexicon: Lexicon) -> [(String, String)]? {
+        // Адреса и e-mail теггер помечает как ADD - правилами не угадать
+        if text.contains("@") || text.contains("://") || text.contains("www.") {
+            return nil
+        }
+
+        let tokens = tokenize(text)
+        var pairs: [(String, String)] = []
+        pairs.reserveCapacity(tokens.count)
+        var sentenceStart = true
+
+        for (index, token) in tokens.enumerated() {
+            let next = index + 1 < tokens.count ? tokens[index + 1] : nil
+
+            if token.count == 1, let char = token.first, isPunctuation(char) {
+                guard let tag = punctuationTag(char, next: next) else { return nil }
+                pairs.append((token, tag))
+                if char == "." || char == "!" || char == "?" {
+                    sentenceStart = true
+                }
+                continue
+            }
+
+            if token.first?.isNumber == true {
+                pairs.append((token, "CD"))
+                sentenceStart = false
+                continue
+            }
+
+            // Сокращение: "don", "'", "t" - проверяем собранные формы
+            if index >= 2, tokens[index - 1] == "'" || tokens[index - 1] == "\u{2019}",
+               lexicon.isPOSSensitive("'" + token) || lexicon.isPOSSensitive(tokens[index - 2] + "'" + token) {
+                return nil
+            }
+
+            guard let tag = wordTag(token, next: next, sentenceStart: sentenceStart, lexicon: lexicon) else {
+                return nil
+            }
+            pairs.append((token, tag))
+            sentenceStart = false
+        }
+        return pairs
+    }
+
+    /// Токенизация как BasicTokenizer BERT: пробелы и пунктуация
+    static func tokenize(_ text: String) -> [String] {
+        var tokens: [String] = []
+        var current = ""
+        for char in text {
+            if char.isWhitespace {
+                if !current.isEmpty {
+                    tokens.append(current)
+                    current = ""
+                }
+            } else if isPunctuation(char) {
+                if !current.isEmpty {
+                    tokens.append(current)
+                    current = ""
+                }
+                tokens.append(String(char))
+            } else {
+                current.append(char)
+            }
+        }
+        if !current.isEmpty {
+            tokens.append(current)
+        }
+        return tokens
+    }
+
+    // MARK: - Private
+
+    private static func wordTag(_ word: String, next: String?, sentenceStart: Bool, lexicon: Lexicon) -> String? {
+        if lexicon.isPOSSensitive(word) {
+            return nil
+        }
+
+        let lowered = word.lowercased()
+        let isLowercase = word == lowered
+        let isFollowedByPunctuation = next.map { $0.count == 1 && isPunctuation($0.first!) } ?? true
+
+        if word == "I" {
+            return "PRP"
+        }
+        if isLowercase {
+            // "come in.", "pass by." - частица/наречие, иначе предлог
+            if lowered == "in" {
+                return isFollowedByPunctuation ? "RP" : "IN"
+            }
+            if lowered == "by" {
+                return isFollowedByPunctuation ? "RB" : "IN"
+            }
+            return closedClassTags[lowered] ?? "NN"
+        }
+        // "A"/"IN"/"TO"/"THE" и аббревиатуры: тег решает, читать ли по буквам
+        if word == word.uppercased() {
+            return nil
+        }
+        // Слово с заглавной: в начале предложения - обычное слово, дальше - имя собственное.
+        // Незнакомое слово в начале предложения может оказаться и тем и другим.
+        if sentenceStart {
+            guard lexicon.contains(word) else { return nil }
+            return closedClassTags[lowered] ?? "NN"
+        }
+        return "NNP"
+    }
+
+    /// Тег знака; `nil` для дефиса - HYPH или тире (":") по правилам не различить
+    private static func punctuationTag(_ char: Character, next: String?) -> String? {
+        switch char {
+        case ".", "!", "?":
+            return "."
+        case ",":
+            return ","
+        case ":", ";", "—", "…":
+            return ":"
+        case "-", "–":
+            return nil
+        case "%":
+            return "NN"
+        case "&", "+":
+            return "CC"
+        case "/", "=":
+            return "SYM"
+        case "$":
+            return "$"
+        case "#":
+            return "#"
+        case "(", "[", "{":
+            return "-LRB-"
+        case ")", "]", "}":
+            return "-RRB-"
+        case "“", "«":
+            return "``"
+        case "”", "»", "'", "\u{2019}":
+            return "''"
+        case "\"":
+            // Открывающая кавычка перед словом, закрывающая - в остальных случаях
+            let opensQuote = next.map { !($0.count == 1 && isPunctuation($0.first!)) } ?? false
+            return opensQuote ? "``" : "''"
+        default:
+            return "NFP"
+        }
+    }
+
+    private static func isPunctuation(_ char: Character) -> Bool {
+        guard let scalar = char.unicodeScalars.first, char.unicodeScalars.count == 1 else {
+            return false
+        }
+        if scalar.isASCII {
+            // BERT считает пунктуацией все ASCII-символы, кроме букв, цифр и пробелов
+            return !(scalar.properties.isAlphabetic || ("0"..."9").contains(scalar) || scalar.properties.isWhitespace)
+        }
+        switch scalar.properties.generalCategory {
+        case .connectorPunctuation, .dashPunctuation, .openPunctuation, .closePunctuation,
+             .initialPunctuation, .finalPunctuation, .otherPunctuation:
+            return true
+        default:
+            return false
+        }
+    }
+
+    /// Служебные слова, теги которых не зависят от контекста
+    private static let closedClassTags: [String: String] = [
+        "the": "DT", "a": "DT", "an": "DT", "this": "DT", "that": "DT", "these": "DT", "those": "DT",
+        "to": "TO",
+        "of": "IN", "on": "IN", "at": "IN", "for": "IN", "with": "IN", "from": "IN", "into": "IN", "about": "IN",
+        "and": "CC", "or": "CC", "but": "CC",
+        "i": "PRP", "you": "PRP", "he": "PRP", "she": "PRP", "it": "PRP", "we": "PRP", "they": "PRP",
+        "is": "VBZ", "are": "VBP", "was": "VBD", "were": "VBD", "be": "VB", "been": "VBN"
+    ]
+}
@@ -0,0 +1,102 @@
+import Foundation
+
+/// Разбиение длинного текста на предложения для параллельной фонемизации.
+///
+/// Граница - `.`, `!`, `?` или `…` (с закрывающими кавычками и скобками)
+/// перед пробелом, либо перевод строки после пунктуации. Внутри markdown-ссылок
+/// `[text](feature)` текст не режется, известные сокращения ("Mr.", "e.g.")
+/// границей не считаются. Пунктуация сбрасывает `TokenContext` в обратном
+/// проходе, поэтому контекст слов по предложениям тот же, что у всего текста.
+/// Перевод строки без пунктуации не граница: последнее слово строки зависит
+/// от первого слова следующей ("the" перед "apple" читается иначе, чем перед "pear").
+enum SentenceSplitter {
+
+    static func split(_ text: String) -> [Substring] {
+        var sentences: [Substring] = []
+        var sentenceStart = text.startIndex
+        var bracketDepth = 0
+        var parenDepth = 0
+        var index = text.startIndex
+
+        func emit(upTo end: String.Index) {
+            let sentence = text[sentenceStart..<end].trimmingWhitespace()
+            if !sentence.isEmpty {
+                sentences.append(sentence)
+            }
+        }
+
+        while index < text.endIndex {
+            let char = text[index]
+            let next = text.index(after: index)
+
+            switch char {
+            case "[":
+                bracketDepth += 1
+            case "]":
+                bracketDepth = max(bracketDepth - 1, 0)
+            case "(" where index > text.startIndex && text[text.index(before: index)] == "]":
+                parenDepth += 1
+            case ")" where parenDepth > 0:
+                parenDepth -= 1
+            case "\n", "\r\n":
+                if bracketDepth == 0 && parenDepth == 0 && endsWithContextReset(text[sentenceStart..<index]) {
+                    emit(upTo: index)
+                    sentenceStart = next
+                }
+            case _ where terminators.contains(char) && bracketDepth == 0 && parenDepth == 0:
+                // Закрывающие кавычки и скобки остаются в текущем предложении
+                var end = next
+                while end < text.endIndex && closers.contains(text[end]) {
+                    end = text.index(after: end)
+                }
+                let isAbbreviation = char == "." && endsWithAbbreviation(text[sentenceStart..<index])
+                if (end == text.endIndex || text[end].isWhitespace) && !isAbbreviation {
+                    emit(upTo: end)
+                    sentenceStart = end
+                    index = end
+                    continue
+                }
+            default:
+                break
+            }
+            index = next
+        }
+        emit(upTo: text.endIndex)
+        return sentences
+    }
+
+    private static let terminators: Set<Character> = [".", "!", "?", "…"]
+    private static let closers: Set<Character> = ["\"", "'", "”", "’", ")", "»"]
+    /// Знаки, после которых `tokenContext` в `G2PEn` возвращает пустой контекст (NON_QUOTE_PUNCTS)
+    private static let contextResets: Set<Character> = [";", ":", ",", ".", "!", "?", "—", "…"]
+    private static let abbreviations: Set<String> = [
+        "mr", "mrs", "ms", "dr", "st", "jr", "sr", "prof", "vs", "etc", "e.g", "i.e", "a.m", "p.m", "approx", "inc", "ltd"
+    ]
+
+    /// Строка кончается пунктуацией (не считая закрывающих кавычек и скобок), и это не сокращение
+    private static func endsWithContextReset(_ line: Substring) -> Bool {
+        let line = line.trimmingWhitespace()
+        guard let last = line.lastIndex(where: { !closers.contains($0) }), contextResets.contains(line[last]) else {
+            return false
+        }
+        return line[last] != "." || !endsWithAbbreviation(line[..<last])
+    }
+
+    /// Слово перед точкой - сокращение или одиночная буква ("J. R. R. Tolkien")
+    private static func endsWithAbbreviation(_ text: Substring) -> Bool {
+        let word = text.reversed().prefix { !$0.isWhitespace && $0 != "(" && $0 != "\"" }
+        guard !word.isEmpty else { return false }
+        let lowered = String(word.reversed()).lowercased()
+        return abbreviations.contains(lowered) || (lowered.count == 1 && lowered.first!.isLetter)
+    }
+}
+
+private extension Substring {
+    func trimmingWhitespace() -> Substring {
+        guard let first = firstIndex(where: { !$0.isWhitespace }),
+              let last = lastIndex(where: { !$0.isWhitespace }) else {
+            return self[endIndex...]
+        }
+        return self[first...last]
+    }
+}
@@ -0,0 +1,131 @@
+import Foundation
+
+/// Однопроходная предобработка текста по UTF-8 байтам (замена regex-версии `G2PEn.preprocess`).
+///
+/// За один проход обрезает пробелы по краям, режет текст на токены по пробелам
+/// и разбирает markdown-ссылки `[text](feature)`. ASCII-байты обрабатываются
+/// напрямую, многобайтовые последовательности декодируются только чтобы
+/// распознать Unicode-пробелы. Семантика совпадает
+/// с `trimmingCharacters(in:)`/`components(separatedBy:)` для
+/// `.whitespacesAndNewlines` и с regex `\[([^\]]+)\]\(([^\)]*)\)`.
+enum TextNormalizer {
+
+    static func normalize(_ text: String) -> G2PEn.PreprocessResult {
+        var text = text
+        return text.withUTF8 { normalize(bytes: $0) }
+    }
+
+    static func normalize(bytes: UnsafeBufferPointer<UInt8>) -> G2PEn.PreprocessResult {
+        var result: [UInt8] = []
+        var tokens: [String] = []
+        var features: [Int: Any] = [:]
+
+        // text.strip()
+        var start = 0
+        var end = bytes.count
+        while start < end {
+            let (isSpace, length) = whitespace(bytes, at: start)
+            guard isSpace else { break }
+            start += length
+        }
+        while end > start {
+            var scalarStart = end - 1
+            while scalarStart > start && bytes[scalarStart] & 0xC0 == 0x80 {
+                scalarStart -= 1
+            }
+            guard whitespace(bytes, at: scalarStart).isSpace else { break }
+            end = scalarStart
+        }
+        result.reserveCapacity(end - start)
+
+        var segmentStart = start  // начало текста вне ссылок, еще не скопированного в result
+        var tokenStart = -1
+        var i = start
+
+        func flushToken(upTo index: Int) {
+            guard tokenStart >= 0 else { return }
+            let token = UnsafeBufferPointer(rebasing: bytes[tokenStart..<index])
+            tokens.append(String(decoding: token, as: UTF8.self))
+            tokenStart = -1
+        }
+
+        while i < end {
+            let byte = bytes[i]
+
+            if byte == UInt8(ascii: "["), let link = matchLink(bytes, at: i, end: end) {
+                // Текст до ссылки: result += text[last_end:m.start()]; tokens.extend(...split())
+                flushToken(upTo: i)
+                result.append(contentsOf: bytes[segmentStart..<i])
+
+                let linkText = UnsafeBufferPointer(rebasing: bytes[link.text])
+                let feature = String(decoding: UnsafeBufferPointer(rebasing: bytes[link.feature]), as: UTF8.self)
+                if let f = G2PEn.parseFeature(feature) {
+                    features[tokens.count] = f
+                }
+                result.append(contentsOf: linkText)
+                tokens.append(String(decoding: linkText, as: UTF8.self))
+
+                i = link.end
+                segmentStart = i
+                continue
+            }
+
+            let (isSpace, length) = whitespace(bytes, at: i)
+            if isSpace {
+                flushToken(upTo: i)
+            } else if tokenStart < 0 {
+                tokenStart = i
+            }
+            i += length
+        }
+        flushToken(upTo: end)
+        result.append(contentsOf: bytes[segmentStart..<end])
+
+        return G2PEn.PreprocessResult(
+            result: String(decoding: result, as: UTF8.self),
+            tokens: tokens,
+            features: features
+        )
+    }
+
+    // MARK: - Private
+
+    /// `\[([^\]]+)\]\(([^\)]*)\)` с позиции `[`: первая `]` после непустого текста,
+    /// сразу за ней `(`, затем первая `)`
+    private static func matchLink(_ bytes: UnsafeBufferPointer<UInt8>, at open: Int, end: Int) -> (text: Range<Int>, feature: Range<Int>, end: Int)? {
+        var close = open + 1
+        while close < end && bytes[close] != UInt8(ascii: "]") {
+            close += 1
+        }
+        guard close < end, close > open + 1,
+              close + 1 < end, bytes[close + 1] == UInt8(ascii: "(") else {
+            return nil
+        }
+        var featureEnd = close + 2
+        while featureEnd < end && bytes[featureEnd] != UInt8(ascii: ")") {
+            featureEnd += 1
+        }
+        guard featureEnd < end else { return nil }
+        return (open + 1..<close, close + 2..<featureEnd, featureEnd + 1)
+    }
+
+    /// Пробел ли скаляр в позиции `index` (`.whitespacesAndNewlines`) и длина скаляра в байтах
+    @inline(__always)
+    private static func whitespace(_ bytes: UnsafeBufferPointer<UInt8>, at index: Int) -> (isSpace: Bool, length: Int) {
+        let byte = bytes[index]
+        if byte < 0x80 {
+            return (byte == 0x20 || (byte >= 0x09 && byte <= 0x0D), 1)
+        }
+        let length = byte >= 0xF0 ? 4 : byte >= 0xE0 ? 3 : 2
+        var value = UInt32(byte) & (length == 2 ? 0x1F : length == 3 ? 0x0F : 0x07)
+        for offset in 1..<length where index + offset < bytes.count {
+            value = value << 6 | UInt32(bytes[index + offset] & 0x3F)
+        }
+        switch value {
+        case 0x85, 0xA0, 0x1680, 0x2000...0x200A, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000:
+            return (true, length)
+        default:
+            return (false, length)
+        }
+    }
+}
@@ -0,0 +1,116 @@
+import Foundation
+
+/// Токены предложения в виде структуры массивов (после `retokenize`).
+///
+/// Каждое поле `MToken` лежит в своем массиве, токен - это индекс. Слова
+/// ссылаются на токены индексами: одиночный токен или непрерывный диапазон
+/// подтокенов без пробелов между ними. `retokenize` добавляет токены строго
+/// по порядку, поэтому слова покрывают таблицу без пропусков.
+struct TokenTable {
+
+    /// Слово как в Python: отдельный токен или список подтокенов
+    enum Word: Equatable {
+        case single(Int)
+        case group(Range<Int>)
+    }
+
+    private(set) var text: [String] = []
+    private(set) var tag: [String] = []
+    var whitespace: [String] = []
+    var phonemes: [String?] = []
+    var rating: [Int?] = []
+    private(set) var startTs: [Double?] = []
+    private(set) var endTs: [Double?] = []
+
+    // MToken.Underscore
+    var isHead: [Bool] = []
+    var alias: [String?] = []
+    var stress: [Double?] = []
+    var currency: [String?] = []
+    var numFlags: [String] = []
+    var prespace: [Bool] = []
+    var underscoreRating: [Int?] = []
+
+    var words: [Word] = []
+
+    var count: Int {
+        return text.count
+    }
+
+    init(capacity: Int = 0) {
+        text.reserveCapacity(capacity)
+        tag.reserveCapacity(capacity)
+        whitespace.reserveCapacity(capacity)
+        phonemes.reserveCapacity(capacity)
+        rating.reserveCapacity(capacity)
+        startTs.reserveCapacity(capacity)
+        endTs.reserveCapacity(capacity)
+        isHead.reserveCapacity(capacity)
+        alias.reserveCapacity(capacity)
+        stress.reserveCapacity(capacity)
+        currency.reserveCapacity(capacity)
+        numFlags.reserveCapacity(capacity)
+        prespace.reserveCapacity(capacity)
+        underscoreRating.reserveCapacity(capacity)
+        words.reserveCapacity(capacity)
+    }
+
+    /// Добавляет токен в конец таблицы
+    /// - Returns: Индекс токена
+    @discardableResult
+    mutating func append(_ token: MToken) -> Int {
+        text.append(token.text)
+        tag.append(token.tag)
+        whitespace.append(token.whitespace)
+        phonemes.append(token.phonemes)
+        rating.append(token.rating)
+        startTs.append(token.startTs)
+        endTs.append(token.endTs)
+        isHead.append(token.underscore.isHead)
+        alias.append(token.underscore.alias)
+        stress.append(token.underscore.stress)
+        currency.append(token.underscore.currency)
+        numFlags.append(token.underscore.numFlags)
+        prespace.append(token.underscore.prespace)
+        underscoreRating.append(token.underscore.rating)
+        return text.count - 1
+    }
+
+    /// Токен в виде значения (для лексикона и `mergeTokens`)
+    subscript(index: Int) -> MToken {
+        return MToken(
+            text: text[index],
+            tag: tag[index],
+            whitespace: whitespace[index],
+            phonemes: phonemes[index],
+            rating: rating[index],
+            startTs: startTs[index],
+            endTs: endTs[index],
+            underscore: MToken.Underscore(
+                isHead: isHead[index],
+                alias: alias[index],
+                stress: stress[index],
+                currency: currency[index],
+                numFlags: numFlags[index],
+                prespace: prespace[index],
+                rating: underscoreRating[index]
+            )
+        )
+    }
+
+    /// Токены диапазона без промежуточного массива; каждое обращение собирает `MToken` заново,
+    /// поэтому обходить один раз
+    func tokens(in range: Range<Int>) -> LazyMapCollection<Range<Int>, MToken> {
+        return range.lazy.map { self[$0] }
+    }
+
+    /// Индексы токенов слова
+    func indices(of word: Word) -> Range<Int> {
+        switch word {
+        case .single(let index):
+            return index..<(index + 1)
+        case .group(let range):
+            return range
+        }
+    }
+}
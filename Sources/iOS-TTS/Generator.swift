@@ -3,9 +3,10 @@ import CoreML
 
 /// Generator model for converting decoder output to audio
 public class Generator {
-    private let generator: MLModel
-    private let f0Upsample: MLModel
-    private let sourceModule: MLModel
+    private let generator: ResidentResource<MLModel>
+    private let f0Upsample: ResidentResource<MLModel>
+    private let sourceModule: ResidentResource<MLModel>
+    private let outputBackings: OutputBackingPool?
     private let sineGen: SineGen
     private let rosaStft: RosaKitSTFT
     
@@ -14,10 +15,21 @@ public class Generator {
     ///   - generatorModel: The main generator model
     ///   - f0UpsampleModel: The F0 upsampling model
     ///   - sourceModuleModel: The source module model
-    public init(generatorModel: MLModel, f0UpsampleModel: MLModel, sourceModuleModel: MLModel) {
-        self.generator = generatorModel
-        self.f0Upsample = f0UpsampleModel
-        self.sourceModule = sourceModuleModel
+    public convenience init(generatorModel: MLModel, f0UpsampleModel: MLModel, sourceModuleModel: MLModel) {
+        self.init(
+            generator: ResidentResource(name: "Generator", resident: generatorModel),
+            f0Upsample: ResidentResource(name: "F0Upsample", resident: f0UpsampleModel),
+            sourceModule: ResidentResource(name: "SourceModuleHnNSF", resident: sourceModuleModel)
+        )
+    }
+    
+    /// Initialize generator with models managed by a `ModelResidencyManager`; each loads on first use
+    /// - Parameter outputBackings: Pool the model outputs are written into, `nil` lets Core ML allocate them
+    init(generator: ResidentResource<MLModel>, f0Upsample: ResidentResource<MLModel>, sourceModule: ResidentResource<MLModel>, outputBackings: OutputBackingPool? = nil) {
+        self.generator = generator
+        self.f0Upsample = f0Upsample
+        self.sourceModule = sourceModule
+        self.outputBackings = outputBackings
         self.sineGen = SineGen()
         self.rosaStft = RosaKitSTFT(filterLength: 20, hopLength: 5, winLength: 20)
     }
@@ -48,6 +60,34 @@ public class Generator {
     /// - Returns: Generated audio samples
     /// - Throws: Error if generation fails
     public func generate(x: MLMultiArray, s: MLMultiArray, f0Curve: MLMultiArray) throws -> [Float] {
+        let sink = ArrayAudioSink()
+        try generate(x: x, s: s, f0Curve: f0Curve, into: sink)
+        return sink.samples
+    }
+    
+    /// Generate audio from decoder output straight into `sink`
+    /// - Parameters:
+    ///   - x: Decoder output tensor
+    ///   - s: Style vector
+    ///   - f0Curve: F0 curve from decoder
+    ///   - seed: Seed of the harmonic source noise, `nil` for fresh noise
+    ///   - sampleLimit: Samples to keep, `nil` for all; drops the audio of bucket-padded frames
+    ///   - sink: Receives the iSTFT output without an intermediate array
+    /// - Returns: Number of samples written
+    /// - Throws: Error if generation or the sink fails
+    @discardableResult
+    public func generate(x: MLMultiArray, s: MLMultiArray, f0Curve: MLMultiArray, seed: UInt64? = nil, sampleLimit: Int? = nil, into sink: AudioSink) throws -> Int {
+        guard let outputBackings = outputBackings else {
+            return try generate(x: x, s: s, f0Curve: f0Curve, seed: seed, sampleLimit: sampleLimit, lease: nil, into: sink)
+        }
+        let lease = BackingLease()
+        defer { outputBackings.finish(lease) }
+        return try generate(x: x, s: s, f0Curve: f0Curve, seed: seed, sampleLimit: sampleLimit, lease: lease, into: sink)
+    }
+    
+    /// Generate audio with model outputs in buffers held by `lease` (see `OutputBackingPool`)
+    @discardableResult
+    func generate(x: MLMultiArray, s: MLMultiArray, f0Curve: MLMultiArray, seed: UInt64?, sampleLimit: Int?, lease: BackingLease?, into sink: AudioSink) throws -> Int {
         let monitor = PerformanceMonitor.shared
         
         print("🎵 Generator starting with inputs:")
@@ -55,6 +95,9 @@ public class Generator {
         print("   s shape: \(s.shape), elements: \(s.count)")
         print("   f0Curve shape: \(f0Curve.shape), elements: \(f0Curve.count)")
         
+        // Cancellation is checked before every step; a cancelled task skips the rest of the vocoder
+        try Task.checkCancellation()
+        
         // Step 1: Upsample F0
         let f0UpsampleOutput = try monitor.measure(PerformanceMonitor.Module.f0Upsample) {
             let f0Input = try reshapeF0ForUpsample(f0Curve)
@@ -65,7 +108,7 @@ public class Generator {
             ])
             
             print("▶️ Calling F0 Upsample model...")
-            let output = try f0Upsample.prediction(from: f0UpsampleInput)
+            let output = try predict(f0Upsample, name: "F0Upsample", from: f0UpsampleInput, lease: lease)
             print("✅ F0 Upsample completed successfully")
             return output
         }
@@ -79,21 +122,23 @@ public class Generator {
         print("🔄 F0 transposed: \(f0Transposed.shape), elements: \(f0Transposed.count)")
         
         // Step 2: Generate sine waves using SineGen
+        try Task.checkCancellation()
         let sineWaves = try monitor.measure(PerformanceMonitor.Module.sineGen) {
             print("▶️ Calling SineGen...")
-            let output = try sineGen.forward(f0Transposed)
+            let output = try sineGen.forward(f0Transposed, seed: seed)
             print("✅ SineGen completed, output shape: \(output.shape), elements: \(output.count)")
             return output
         }
         
         // Step 3: Process through source module
+        try Task.checkCancellation()
         let sourceOutput = try monitor.measure(PerformanceMonitor.Module.sourceModule) {
             let sourceInput = try MLDictionaryFeatureProvider(dictionary: [
                 "sine_wavs": MLFeatureValue(multiArray: sineWaves)
             ])
             
             print("▶️ Calling Source Module...")
-            let output = try sourceModule.prediction(from: sourceInput)
+            let output = try predict(sourceModule, name: "SourceModuleHnNSF", from: sourceInput, lease: lease)
             print("✅ Source Module completed successfully")
             return output
         }
@@ -107,6 +152,7 @@ public class Generator {
         print("🔄 After transpose and squeeze: \(harSource.shape), elements: \(harSource.count)")
         
         // Step 4: Apply STFT to get harmonics using RosaKit
+        try Task.checkCancellation()
         let (harSpec, harPhase) = try monitor.measure(PerformanceMonitor.Module.stft) {
             print("▶️ Calling STFT transform...")
             let result = try rosaStft.transform(harSource)
@@ -119,6 +165,7 @@ public class Generator {
         print("🔗 Concatenated harmonics: \(har.shape), elements: \(har.count)")
         
         // Step 5: Generate through main generator
+        try Task.checkCancellation()
         let generatorOutput = try monitor.measure("Generator Core") {
             print("🎛️ Generator Core inputs:")
             print("   x: \(x.shape), elements: \(x.count)")
@@ -132,7 +179,7 @@ public class Generator {
             ])
             
             print("▶️ Calling Generator Core model...")
-            let output = try generator.prediction(from: generatorInput)
+            let output = try predict(generator, name: "Generator", from: generatorInput, lease: lease)
             print("✅ Generator Core completed successfully")
             return output
         }
@@ -143,6 +190,7 @@ public class Generator {
         print("📊 Generator output - spec: \(spec.shape), phase: \(phase.shape)")
         
         // Step 6: Apply inverse STFT to get audio
+        try Task.checkCancellation()
         let audio = try monitor.measure(PerformanceMonitor.Module.inverseSTFT) {
             print("▶️ Calling inverse STFT...")
             print("   spec: \(spec.shape), elements: \(spec.count)")
@@ -152,18 +200,24 @@ public class Generator {
             return result
         }
         
-        // Convert to 1D array
-        let audioLength = audio.shape[2].intValue
-        var audioArray = [Float](repeating: 0, count: audioLength)
-        for i in 0..<audioLength {
-            audioArray[i] = audio[[0, 0, i as NSNumber]].floatValue
+        // The iSTFT output is a contiguous [1, 1, length] float32 array: hand its storage to the sink
+        let audioLength = min(audio.shape[2].intValue, sampleLimit ?? .max)
+        try audio.withUnsafeBufferPointer(ofType: Float.self) { samples in
+            try sink.write(UnsafeBufferPointer(rebasing: samples.prefix(audioLength)))
         }
         
-        return audioArray
+        return audioLength
     }
     
     // MARK: - Private Methods
     
+    private func predict(_ model: ResidentResource<MLModel>, name: String, from input: MLFeatureProvider, lease: BackingLease?) throws -> MLFeatureProvider {
+        guard let outputBackings = outputBackings else {
+            return try model.get().prediction(from: input)
+        }
+        return try outputBackings.prediction(model.get(), name: name, from: input, lease: lease)
+    }
+    
     private func reshapeF0ForUpsample(_ f0Curve: MLMultiArray) throws -> MLMultiArray {
         // F0 curve shape: [1, sequence_length] -> [1, 1, sequence_length]
         let batchSize = 1
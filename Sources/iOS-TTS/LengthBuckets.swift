@@ -0,0 +1,160 @@
+import Foundation
+
+/// Fixed input lengths that token sequences and duration frames are padded up to.
+///
+/// Without buckets every utterance presents new shapes to BERT, the text
+/// encoders, the decoder and Generator Core, so Core ML cannot reuse a
+/// shape-specialized plan or its buffers. With buckets the token ids are
+/// padded (masked out of attention and the text mask, zero duration) and the
+/// alignment gets zero columns up to the frame bucket; the vocoder output is
+/// trimmed back to the real frames.
+///
+/// Bucketed audio is not the same as unbucketed audio. The masks only cover
+/// attention and the masked fills: DurationEncoder, TextEncoder,
+/// ProsodyPredictor and F0Predictor contain bidirectional LSTMs that run over
+/// the pad tokens and zero frames, and the backward direction reaches every
+/// real token through them. Durations, F0 and energy of the whole utterance
+/// can shift, most for short utterances in large buckets, and the decoder's
+/// convolutions also see the zero frames at the end. Compare bucketed and
+/// unbucketed output for your voices before enabling buckets; cached audio is
+/// keyed by the bucket set so the two never mix.
+public struct LengthBuckets: Hashable, Sendable {
+    /// Token bucket sizes, ascending; the two pads count as tokens
+    public let tokens: [Int]
+    /// Duration frame bucket sizes, ascending
+    public let frames: [Int]
+
+    public init(tokens: [Int], frames: [Int]) {
+        self.tokens = Array(Set(tokens.filter { $0 > 0 })).sorted()
+        self.frames = Array(Set(frames.filter { $0 > 0 })).sorted()
+    }
+
+    /// No padding: every request runs at its own length
+    public static let none = LengthBuckets(tokens: [], frames: [])
+
+    /// Powers of two up to the 512-token model limit, frames at about three per token.
+    /// Trades prosody fidelity for shape reuse, see the type documentation.
+    public static let standard = LengthBuckets(
+        tokens: [32, 64, 128, 256, 512],
+        frames: [128, 256, 512, 1024, 2048]
+    )
+
+    public var isEnabled: Bool {
+        return !tokens.isEmpty || !frames.isEmpty
+    }
+
+    /// Smallest token bucket holding `count`, or `count` itself when none does
+    public func tokenBucket(for count: Int) -> Int {
+        return LengthBuckets.bucket(for: count, in: tokens)
+    }
+
+    /// Smallest frame bucket holding `count`, or `count` itself when none does
+    public func frameBucket(for count: Int) -> Int {
+        return LengthBuckets.bucket(for: count, in: frames)
+    }
+
+    /// Part of the synthesis cache key, empty without buckets so existing entries stay valid
+    var cacheTag: String {
+        guard isEnabled else { return "" }
+        return "#t" + tokens.map(String.init).joined(separator: ",") + "#f" + frames.map(String.init).joined(separator: ",")
+    }
+
+    private static func bucket(for count: Int, in sizes: [Int]) -> Int {
+        return sizes.first { $0 >= count } ?? count
+    }
+}
+
+/// Which input lengths the model actually saw, to tune `LengthBuckets` against real traffic.
+///
+/// Keys are the padded lengths, so without buckets the histograms are the
+/// raw length distribution.
+public struct LengthBucketReport: Sendable {
+    /// Inferences per padded token length
+    public let tokenHits: [Int: Int]
+    /// Inferences per padded frame length
+    public let frameHits: [Int: Int]
+    /// Inferences longer than the largest token bucket
+    public let tokenOverflows: Int
+    /// Inferences longer than the largest frame bucket (or capped by the peak memory limit)
+    public let frameOverflows: Int
+    public let tokens: Int
+    public let paddedTokens: Int
+    public let frames: Int
+    public let paddedFrames: Int
+
+    public var inferences: Int {
+        return tokenHits.values.reduce(0, +)
+    }
+
+    /// Extra token positions computed per real one
+    public var tokenPaddingOverhead: Double {
+        return tokens == 0 ? 0 : Double(paddedTokens - tokens) / Double(tokens)
+    }
+
+    /// Extra frames computed per real one
+    public var framePaddingOverhead: Double {
+        return frames == 0 ? 0 : Double(paddedFrames - frames) / Double(frames)
+    }
+}
+
+/// Accumulates `LengthBucketReport` from inference traces
+final class LengthBucketStatistics: @unchecked Sendable {
+    private let lock = NSLock()
+    private var tokenHits: [Int: Int] = [:]
+    private var frameHits: [Int: Int] = [:]
+    private var tokenOverflows = 0
+    private var frameOverflows = 0
+    private var tokens = 0
+    private var paddedTokens = 0
+    private var frames = 0
+    private var paddedFrames = 0
+
+    /// Counts a finished inference run with `buckets`
+    func record(_ trace: InferenceTrace, buckets: LengthBuckets) {
+        guard let realFrames = trace.frames else { return }
+        let tokenLength = trace.paddedTokens ?? trace.tokens
+        let frameLength = trace.paddedFrames ?? realFrames
+        lock.lock()
+        defer { lock.unlock() }
+        tokenHits[tokenLength, default: 0] += 1
+        frameHits[frameLength, default: 0] += 1
+        if let largest = buckets.tokens.last, trace.tokens > largest {
+            tokenOverflows += 1
+        }
+        if !buckets.frames.isEmpty, !buckets.frames.contains(frameLength) {
+            frameOverflows += 1
+        }
+        tokens += trace.tokens
+        paddedTokens += tokenLength
+        frames += realFrames
+        paddedFrames += frameLength
+    }
+
+    func report() -> LengthBucketReport {
+        lock.lock()
+        defer { lock.unlock() }
+        return LengthBucketReport(
+            tokenHits: tokenHits,
+            frameHits: frameHits,
+            tokenOverflows: tokenOverflows,
+            frameOverflows: frameOverflows,
+            tokens: tokens,
+            paddedTokens: paddedTokens,
+            frames: frames,
+            paddedFrames: paddedFrames
+        )
+    }
+
+    func reset() {
+        lock.lock()
+        defer { lock.unlock() }
+        tokenHits = [:]
+        frameHits = [:]
+        tokenOverflows = 0
+        frameOverflows = 0
+        tokens = 0
+        paddedTokens = 0
+        frames = 0
+        paddedFrames = 0
+    }
+}
@@ -0,0 +1,91 @@
+import Foundation
+import CoreML
+import Accelerate
+
+/// Float32 matrix over existing storage with arbitrary row and column strides.
+///
+/// A transpose is a view with the strides swapped, so operations take
+/// transposed operands in place instead of materializing a copy first.
+struct MatrixView {
+    let base: UnsafeMutablePointer<Float>
+    let rows: Int
+    let columns: Int
+    /// Elements between consecutive rows
+    let rowStride: Int
+    /// Elements between consecutive columns
+    let columnStride: Int
+
+    init(base: UnsafeMutablePointer<Float>, rows: Int, columns: Int, rowStride: Int, columnStride: Int) {
+        self.base = base
+        self.rows = rows
+        self.columns = columns
+        self.rowStride = rowStride
+        self.columnStride = columnStride
+    }
+
+    /// The last two dimensions of a float32 `[1, rows, columns]` array, honouring its strides
+    init(_ array: MLMultiArray) throws {
+        guard array.dataType == .float32, array.shape.count == 3, array.shape[0].intValue == 1 else {
+            throw TTSError.invalidInput("Expected a float32 [1, rows, columns] array, got \(array.dataType.rawValue) \(array.shape)")
+        }
+        self.init(
+            base: array.dataPointer.bindMemory(to: Float.self, capacity: array.count),
+            rows: array.shape[1].intValue,
+            columns: array.shape[2].intValue,
+            rowStride: array.strides[1].intValue,
+            columnStride: array.strides[2].intValue
+        )
+    }
+
+    var transposed: MatrixView {
+        return MatrixView(base: base, rows: columns, columns: rows, rowStride: columnStride, columnStride: rowStride)
+    }
+
+    subscript(row: Int, column: Int) -> Float {
+        return base[row * rowStride + column * columnStride]
+    }
+
+    /// `[1, columns, rows]` array sharing the storage of `array`, no copy.
+    ///
+    /// Core ML reads inputs through their strides, so a transposed view can be
+    /// fed to a model directly. `array` stays alive as long as the view.
+    static func transposedArray(_ array: MLMultiArray) throws -> MLMultiArray {
+        let view = try MatrixView(array)
+        let batchStride = array.strides[0]
+        return try MLMultiArray(
+            dataPointer: view.base,
+            shape: [1, NSNumber(value: view.columns), NSNumber(value: view.rows)],
+            dataType: .float32,
+            strides: [batchStride, NSNumber(value: view.columnStride), NSNumber(value: view.rowStride)],
+            deallocator: { _ in withExtendedLifetime(array) {} }
+        )
+    }
+
+    /// Writes `output[r, j] = self[r, indices[j]]` into a contiguous `rows × outputColumns` matrix.
+    ///
+    /// This is the product with a one-hot alignment matrix whose column `j`
+    /// has its single 1 in row `indices[j]`, without building that matrix.
+    /// Columns past `indices.count` are zero.
+    /// - Returns: Bytes written
+    @discardableResult
+    func gatherColumns(_ indices: [Int], outputColumns: Int, into output: UnsafeMutablePointer<Float>) -> Int {
+        let count = indices.count
+        precondition(outputColumns >= count, "Output has fewer columns than indices")
+        guard count > 0 else {
+            vDSP_vclr(output, 1, vDSP_Length(rows * outputColumns))
+            return rows * outputColumns * MemoryLayout<Float>.size
+        }
+        // vDSP_vgathr takes 1-based offsets
+        let offsets = indices.map { vDSP_Length($0 * columnStride + 1) }
+        for row in 0..<rows {
+            let destination = output + row * outputColumns
+            offsets.withUnsafeBufferPointer { offsets in
+                vDSP_vgathr(base + row * rowStride, offsets.baseAddress!, 1, destination, 1, vDSP_Length(count))
+            }
+            if outputColumns > count {
+                vDSP_vclr(destination + count, 1, vDSP_Length(outputColumns - count))
+            }
+        }
+        return rows * outputColumns * MemoryLayout<Float>.size
+    }
+}
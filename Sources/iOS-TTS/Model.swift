@@ -9,51 +9,114 @@ import Foundation
 import CoreML
 import Accelerate
 
-public class TTSModel {
-    private let bert: MLModel
-    private let bertEncoder: MLModel
-    private let durationEncoder: MLModel
-    private let prosodyPredictor: MLModel
-    private let f0Predictor: MLModel
-    private let textEncoder: MLModel
-    private let decoder: MLModel
+/// The acoustic model stack: seven stage models plus the vocoder.
+///
+/// Language-agnostic and safe to share between pipelines; Core ML
+/// predictions and the vocoder's DSP keep no per-call state in the instance.
+public final class TTSModel: @unchecked Sendable {
+    private let bert: ResidentResource<MLModel>
+    private let bertEncoder: ResidentResource<MLModel>
+    private let durationEncoder: ResidentResource<MLModel>
+    private let prosodyPredictor: ResidentResource<MLModel>
+    private let f0Predictor: ResidentResource<MLModel>
+    private let textEncoder: ResidentResource<MLModel>
+    private let decoder: ResidentResource<MLModel>
     private let generator: Generator
     
     private let configuration: MLModelConfiguration
     
-    public init(modelPath: URL, configuration: MLModelConfiguration = MLModelConfiguration()) throws {
+    /// Load times measured by `init`
+    public struct LoadReport: Sendable {
+        /// Seconds per `.mlmodelc` bundle, each timed on its own loading thread
+        public let modelSeconds: [String: TimeInterval]
+        /// Seconds until all bundles were loaded
+        public let wallSeconds: TimeInterval
+    }
+    
+    /// Empty when the residency policy defers loading to first use
+    public let loadReport: LoadReport
+    
+    /// Loads, unloads and reports the ten sub-models
+    public let residency: ModelResidencyManager
+    
+    /// Calibrated by every inference over this model, whichever pipeline runs it
+    let costModel = SynthesisCostModel()
+    
+    /// Reused prediction outputs, shared with the generator
+    let outputBackings = OutputBackingPool()
+    
+    /// Output buffer reuse across inferences
+    public var outputBackingStatistics: OutputBackingStatistics {
+        return outputBackings.statistics()
+    }
+    
+    /// Writes sub-model outputs into pooled buffers; turning it off also releases the idle ones
+    public var usesOutputBackings: Bool {
+        get { outputBackings.isEnabled }
+        set { outputBackings.isEnabled = newValue }
+    }
+    
+    /// - Parameter residency: When sub-models are loaded and unloaded; `.resident` loads all of them here
+    public init(
+        modelPath: URL,
+        configuration: MLModelConfiguration = MLModelConfiguration(),
+        residency policy: ModelResidencyPolicy = .resident
+    ) throws {
         self.configuration = configuration
+        let residency = ModelResidencyManager(policy: policy)
+        self.residency = residency
+        
+        // The generator core runs on the CPU, see `Generator.init(modelPath:configuration:)`
+        let generatorConfiguration = MLModelConfiguration()
+        generatorConfiguration.computeUnits = .cpuOnly
+        
+        let bundles: [(name: String, configuration: MLModelConfiguration)] = [
+            ("Albert", configuration),
+            ("BertEncoder", configuration),
+            ("DurationEncoder", configuration),
+            ("ProsodyPredictor", configuration),
+            ("F0Predictor", configuration),
+            ("TextEncoder", configuration),
+            ("Decoder", configuration),
+            ("Generator", generatorConfiguration),
+            ("F0Upsample", configuration),
+            ("SourceModuleHnNSF", configuration),
+        ]
+        let models = try bundles.map { bundle -> ResidentResource<MLModel> in
+            let url = modelPath.appendingPathComponent("\(bundle.name).mlmodelc")
+            // Deferred loads still fail here, not on the first request
+            guard FileManager.default.fileExists(atPath: url.path) else {
+                throw TTSError.modelNotFound(url.path)
+            }
+            return residency.register(name: bundle.name, bytes: ModelResidencyManager.bundleBytes(at: url)) {
+                try MLModel(contentsOf: url, configuration: bundle.configuration)
+            }
+        }
         
-        // Load BERT model
-        let bertURL = modelPath.appendingPathComponent("Albert.mlmodelc")
-        self.bert = try MLModel(contentsOf: bertURL, configuration: configuration)
-        
-        // Load BERT Encoder
-        let bertEncoderURL = modelPath.appendingPathComponent("BertEncoder.mlmodelc")
-        self.bertEncoder = try MLModel(contentsOf: bertEncoderURL, configuration: configuration)
-        
-        // Load Duration Encoder
-        let durationEncoderURL = modelPath.appendingPathComponent("DurationEncoder.mlmodelc")
-        self.durationEncoder = try MLModel(contentsOf: durationEncoderURL, configuration: configuration)
-        
-        // Load Prosody Predictor
-        let prosodyPredictorURL = modelPath.appendingPathComponent("ProsodyPredictor.mlmodelc")
-        self.prosodyPredictor = try MLModel(contentsOf: prosodyPredictorURL, configuration: configuration)
-        
-        // Load F0 Predictor
-        let f0PredictorURL = modelPath.appendingPathComponent("F0Predictor.mlmodelc")
-        self.f0Predictor = try MLModel(contentsOf: f0PredictorURL, configuration: configuration)
-        
-        // Load Text Encoder
-        let textEncoderURL = modelPath.appendingPathComponent("TextEncoder.mlmodelc")
-        self.textEncoder = try MLModel(contentsOf: textEncoderURL, configuration: configuration)
-        
-        // Load Decoder
-        let decoderURL = modelPath.appendingPathComponent("Decoder.mlmodelc")
-        self.decoder = try MLModel(contentsOf: decoderURL, configuration: configuration)
+        self.bert = models[0]
+        self.bertEncoder = models[1]
+        self.durationEncoder = models[2]
+        self.prosodyPredictor = models[3]
+        self.f0Predictor = models[4]
+        self.textEncoder = models[5]
+        self.decoder = models[6]
+        self.generator = Generator(generator: models[7], f0Upsample: models[8], sourceModule: models[9], outputBackings: outputBackings)
+        
+        if policy.loadOnFirstUse {
+            self.loadReport = LoadReport(modelSeconds: [:], wallSeconds: 0)
+        } else {
+            // All ten bundles load concurrently; Core ML compiles and specializes them independently
+            let start = DispatchTime.now().uptimeNanoseconds
+            try residency.load(models)
+            let wallSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            let modelSeconds = Dictionary(uniqueKeysWithValues: models.map { ($0.name, $0.entry().lastLoadSeconds) })
+            self.loadReport = LoadReport(modelSeconds: modelSeconds, wallSeconds: wallSeconds)
+        }
         
-        // Load Generator
-        self.generator = try Generator(modelPath: modelPath, configuration: configuration)
+        // Idle output buffers go with the models on memory warnings and `unloadAll`
+        residency.addPurgeHandler { [outputBackings] in
+            outputBackings.purge()
+        }
     }
     
     // MARK: - Main Inference
@@ -61,41 +124,93 @@ public class TTSModel {
     /// Performs TTS inference with optional pitch modifications.
     ///
     /// - Parameters:
-    ///   - inputIds: Phoneme token IDs from G2P conversion
+    ///   - inputIds: `[1, seqLen]` float32 phoneme token IDs written by `PhonemeTokenizer`
     ///   - refS: Style vector (256 elements: 128 refAudio + 128 style)
     ///   - speed: Speech rate multiplier (0.5-2.0)
     ///   - pitchShiftSemitones: Pitch shift in semitones (-12 to +12)
     ///   - pitchRangeScale: Expressiveness scale (0.5-1.5)
     /// - Returns: Audio samples as Float array
     func infer(
-        inputIds: [Int],
+        inputIds inputIdsArray: MLMultiArray,
         refS: [Float],
         speed: Float,
         pitchShiftSemitones: Float = 0.0,
         pitchRangeScale: Float = 1.0
     ) throws -> [Float] {
+        let sink = ArrayAudioSink()
+        try refS.withUnsafeBufferPointer { refS in
+            try infer(
+                inputIds: inputIdsArray,
+                refS: refS,
+                speed: speed,
+                pitchShiftSemitones: pitchShiftSemitones,
+                pitchRangeScale: pitchRangeScale,
+                into: sink
+            )
+        }
+        return sink.samples
+    }
+    
+    /// Performs TTS inference, writing the vocoder output directly into `sink`.
+    ///
+    /// - Parameters:
+    ///   - refS: Style vector read in place, e.g. a row of the memory-mapped voice pack
+    ///   - validTokens: Real ids at the start of `inputIds`; the rest is bucket padding, masked out of
+    ///     attention and the text mask but still seen by the recurrent layers (see `LengthBuckets`)
+    ///   - buckets: Frame buckets the alignment is padded to; the audio is trimmed to the real frames
+    ///   - seed: Seed of the vocoder noise; equal inputs and seed give equal audio
+    ///   - trace: Collects stage times and the frame total for `SynthesisCostModel`
+    /// - Returns: Number of samples written
+    @discardableResult
+    func infer(
+        inputIds inputIdsArray: MLMultiArray,
+        refS: UnsafeBufferPointer<Float>,
+        speed: Float,
+        pitchShiftSemitones: Float = 0.0,
+        pitchRangeScale: Float = 1.0,
+        validTokens: Int? = nil,
+        buckets: LengthBuckets = .none,
+        seed: UInt64? = nil,
+        trace: InferenceTrace? = nil,
+        into sink: AudioSink
+    ) throws -> Int {
         let monitor = PerformanceMonitor.shared
         
+        /// Bytes written by tensor copies and gathers per stage, reported with the stage times
+        var bytesMoved: [String: Int] = [:]
+        func moved(_ bytes: Int, in module: String) {
+            bytesMoved[module, default: 0] += bytes
+        }
+        defer {
+            trace?.bytesMoved = bytesMoved
+            for (module, bytes) in bytesMoved {
+                monitor.recordBytesMoved(bytes, for: module)
+            }
+        }
+        
+        /// Cancellation checkpoint, then times the stage for the monitor and, when tracing, for the cost model.
+        /// Only completed stages land in the trace, so it also tells how far a cancelled call got.
+        func stage<T>(_ module: String, _ operation: () throws -> T) throws -> T {
+            try Task.checkCancellation()
+            guard let trace = trace else { return try monitor.measure(module, operation: operation) }
+            let start = DispatchTime.now().uptimeNanoseconds
+            let result = try monitor.measure(module, operation: operation)
+            trace.stageSeconds[module] = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+            return result
+        }
+        
+        // Outputs land in pooled buffers that stay valid until this call returns, also when it throws
+        let lease = BackingLease()
+        defer { outputBackings.finish(lease) }
+        
         return try monitor.measure(PerformanceMonitor.Module.total) {
             // Batch size is always 1
-            let seqLen = inputIds.count
+            let seqLen = inputIdsArray.shape[1].intValue
+            let validLength = min(validTokens ?? seqLen, seqLen)
         
-            // Create attention mask (all 1s since we have real tokens, no padding)
-            let attentionMask = Array(repeating: 1, count: seqLen)
-            
-            // Create text mask for other models (0s for real tokens, 1s for padding)
-            // Since we have no padding, all values are 0
-            let textMask = Array(repeating: Float(0), count: seqLen)
-            
-            // Prepare BERT inputs
-            let inputIdsArray = try MLMultiArray(shape: [1, NSNumber(value: seqLen)], dataType: .float32)
-            let attentionMaskArray = try MLMultiArray(shape: [1, NSNumber(value: seqLen)], dataType: .float32)
-            
-            // Convert input_ids to Float16
-            for i in 0..<seqLen {
-                inputIdsArray[[0, i as NSNumber]] = NSNumber(value: Float(inputIds[i]))
-                attentionMaskArray[[0, i as NSNumber]] = NSNumber(value: Float(attentionMask[i]))
-            }
+            // Prepare BERT inputs (input_ids are already written by the tokenizer)
+            // Attention mask: 1s for real tokens, 0s for bucket padding
+            let attentionMaskArray = try TensorBuilder.mask(length: seqLen, valid: validLength, value: 1, fill: 0)
             
             // Call BERT model
             let bertInput = try MLDictionaryFeatureProvider(dictionary: [
@@ -108,12 +223,12 @@ public class TTSModel {
             print("BERT attention_mask shape: \(attentionMaskArray.shape)")
             #endif
             
-            let bertOutput = try monitor.measure(PerformanceMonitor.Module.bert) {
+            let bertOutput = try stage(PerformanceMonitor.Module.bert) {
                 do {
                     #if DEBUG
                     print("Calling BERT model...")
                     #endif
-                    let output = try bert.prediction(from: bertInput)
+                    let output = try outputBackings.prediction(bert.get(), name: "Albert", from: bertInput, lease: lease)
                     #if DEBUG
                     print("BERT model completed successfully")
                     #endif
@@ -136,12 +251,12 @@ public class TTSModel {
             print("BERT Encoder bert_dur shape: \(lastHiddenState.shape), total elements: \(lastHiddenState.count)")
             #endif
             
-            let bertEncoderOutput = try monitor.measure(PerformanceMonitor.Module.bertEncoder) {
+            let bertEncoderOutput = try stage(PerformanceMonitor.Module.bertEncoder) {
                 do {
                     #if DEBUG
                     print("Calling BERT Encoder model...")
                     #endif
-                    let output = try bertEncoder.prediction(from: bertEncoderInput)
+                    let output = try outputBackings.prediction(bertEncoder.get(), name: "BertEncoder", from: bertEncoderInput, lease: lease)
                     #if DEBUG
                     print("BERT Encoder model completed successfully")
                     #endif
@@ -156,23 +271,17 @@ public class TTSModel {
             }
             
             // In Python: d_en = self.bert_encoder(bert_dur).transpose(-1, -2)
-            // Transpose last two dimensions
-            let dEn = try transposeLastTwoDimensions(dEnRaw)
+            // A strided view over the encoder output; Core ML reads it through the strides
+            let dEn = try MatrixView.transposedArray(dEnRaw)
             
             // Split style vector
-            let (refAudio, style) = splitStyleVector(refS)
+            let (refAudio, style) = try splitStyleVector(refS)
             
-            // Prepare text mask for prosody predictor
-            let textMaskArray = try MLMultiArray(shape: [1, NSNumber(value: seqLen)], dataType: .float32)
-            for i in 0..<seqLen {
-                textMaskArray[[0, i as NSNumber]] = NSNumber(value: textMask[i])
-            }
+            // Prepare text mask for prosody predictor (0s for real tokens, 1s for padding)
+            let textMaskArray = try TensorBuilder.mask(length: seqLen, valid: validLength, value: 0, fill: 1)
             
             // Prepare style array
-            let styleArray = try MLMultiArray(shape: [1, 128], dataType: .float32)
-            for i in 0..<128 {
-                styleArray[[0, i as NSNumber]] = NSNumber(value: style[i])
-            }
+            let styleArray = try TensorBuilder.array(copying: style, shape: [1, 128])
             
             // Call Duration Encoder (without speed)
             let durationInput = try MLDictionaryFeatureProvider(dictionary: [
@@ -187,12 +296,12 @@ public class TTSModel {
             print("Duration Encoder mask shape: \(textMaskArray.shape)")
             #endif
             
-            let durationOutput = try monitor.measure(PerformanceMonitor.Module.durationEncoder) {
+            let durationOutput = try stage(PerformanceMonitor.Module.durationEncoder) {
                 do {
                     #if DEBUG
                     print("Calling Duration Encoder model...")
                     #endif
-                    let output = try durationEncoder.prediction(from: durationInput)
+                    let output = try outputBackings.prediction(durationEncoder.get(), name: "DurationEncoder", from: durationInput, lease: lease)
                     #if DEBUG
                     print("Duration Encoder model completed successfully")
                     #endif
@@ -207,8 +316,7 @@ public class TTSModel {
             }
             
             // Prepare speed array (tensor of size (1,))
-            let speedArray = try MLMultiArray(shape: [1], dataType: .float32)
-            speedArray[[0]] = NSNumber(value: speed)
+            let speedArray = try TensorBuilder.array(repeating: speed, shape: [1])
             
             let prosodyInput = try MLDictionaryFeatureProvider(dictionary: [
                 "d": MLFeatureValue(multiArray: d),
@@ -220,12 +328,12 @@ public class TTSModel {
             print("Prosody Predictor speed shape: \(speedArray.shape), value: \(speed)")
             #endif
             
-            let prosodyOutput = try monitor.measure(PerformanceMonitor.Module.prosodyPredictor) {
+            let prosodyOutput = try stage(PerformanceMonitor.Module.prosodyPredictor) {
                 do {
                     #if DEBUG
                     print("Calling Prosody Predictor model...")
                     #endif
-                    let output = try prosodyPredictor.prediction(from: prosodyInput)
+                    let output = try outputBackings.prediction(prosodyPredictor.get(), name: "ProsodyPredictor", from: prosodyInput, lease: lease)
                     #if DEBUG
                     print("Prosody Predictor model completed successfully")
                     #endif
@@ -241,23 +349,35 @@ public class TTSModel {
             }
             
             // Create alignment indices
-            let (_, alignmentMatrix, en) = try monitor.measure(PerformanceMonitor.Module.alignment) {
+            let (indices, columns, en) = try stage(PerformanceMonitor.Module.alignment) {
                 #if DEBUG
                 print("Creating alignment with predDur shape: \(predDur.shape), seqLen: \(seqLen)")
                 #endif
-                let indices = try createAlignmentIndices(predDur: predDur, seqLen: seqLen)
+                // Padding tokens get no frames
+                let indices = try createAlignmentIndices(predDur: predDur, seqLen: validLength)
+                trace?.frames = indices.count
+                // Durations are known now; stop before the frame-sized tensors if they would not fit
+                if let limit = trace?.frameLimit, indices.count > limit {
+                    throw TTSError.invalidInput("Predicted \(indices.count) frames exceed the limit of \(limit) for \(seqLen) tokens")
+                }
                 #if DEBUG
                 print("Alignment indices count: \(indices.count)")
                 #endif
-                let alignmentMatrix = try createAlignmentMatrix(indices: indices, seqLen: seqLen)
-                #if DEBUG
-                print("Alignment matrix shape: \(alignmentMatrix.shape), total elements: \(alignmentMatrix.count)")
-                #endif
-                let en = try applyAlignment(d: d, alignmentMatrix: alignmentMatrix)
+                // Zero columns up to the frame bucket, unless that breaks the memory limit
+                var columns = buckets.frameBucket(for: indices.count)
+                if let limit = trace?.frameLimit, columns > limit {
+                    columns = indices.count
+                }
+                if columns != indices.count {
+                    trace?.paddedFrames = columns
+                }
+                // In Python: en = d.transpose(-1, -2) @ pred_aln_trg, read through a transposed view
+                let en = try align(MatrixView(d).transposed, indices: indices, columns: columns)
+                moved(en.count * MemoryLayout<Float>.size, in: PerformanceMonitor.Module.alignment)
                 #if DEBUG
                 print("Final alignment result shape: \(en.shape), total elements: \(en.count)")
                 #endif
-                return (indices, alignmentMatrix, en)
+                return (indices, columns, en)
             }
             
             // Call F0 Predictor
@@ -271,12 +391,12 @@ public class TTSModel {
             print("F0 Predictor s shape: \(styleArray.shape)")
             #endif
             
-            let f0Output = try monitor.measure(PerformanceMonitor.Module.f0Predictor) {
+            let f0Output = try stage(PerformanceMonitor.Module.f0Predictor) {
                 do {
                     #if DEBUG
                     print("Calling F0 Predictor model...")
                     #endif
-                    let output = try f0Predictor.prediction(from: f0Input)
+                    let output = try outputBackings.prediction(f0Predictor.get(), name: "F0Predictor", from: f0Input, lease: lease)
                     #if DEBUG
                     print("F0 Predictor model completed successfully")
                     #endif
@@ -301,6 +421,7 @@ public class TTSModel {
                     pitchShiftSemitones: pitchShiftSemitones,
                     pitchRangeScale: pitchRangeScale
                 )
+                moved(modifiedF0.count * MemoryLayout<Float>.size, in: PerformanceMonitor.Module.f0Predictor)
                 #if DEBUG
                 print("Applied pitch modifications: shift=\(pitchShiftSemitones), range=\(pitchRangeScale)")
                 #endif
@@ -319,12 +440,12 @@ public class TTSModel {
             print("Text Encoder m shape: \(textMaskArray.shape)")
             #endif
             
-            let textEncoderOutput = try monitor.measure(PerformanceMonitor.Module.textEncoder) {
+            let textEncoderOutput = try stage(PerformanceMonitor.Module.textEncoder) {
                 do {
                     #if DEBUG
                     print("Calling Text Encoder model...")
                     #endif
-                    let output = try textEncoder.prediction(from: textEncoderInput)
+                    let output = try outputBackings.prediction(textEncoder.get(), name: "TextEncoder", from: textEncoderInput, lease: lease)
                     #if DEBUG
                     print("Text Encoder model completed successfully")
                     #endif
@@ -344,16 +465,14 @@ public class TTSModel {
             print("Applying direct alignment to text encoder output")
             print("Text encoder output shape: \(tEn.shape), total elements: \(tEn.count)")
             #endif
-            let asr = try applyAlignmentDirect(input: tEn, alignmentMatrix: alignmentMatrix)
+            let asr = try align(MatrixView(tEn), indices: indices, columns: columns)
+            moved(asr.count * MemoryLayout<Float>.size, in: PerformanceMonitor.Module.alignment)
             #if DEBUG
             print("ASR result shape: \(asr.shape), total elements: \(asr.count)")
             #endif
             
             // Prepare reference audio array
-            let refAudioArray = try MLMultiArray(shape: [1, 128], dataType: .float32)
-            for i in 0..<128 {
-                refAudioArray[[0, i as NSNumber]] = NSNumber(value: refAudio[i])
-            }
+            let refAudioArray = try TensorBuilder.array(copying: refAudio, shape: [1, 128])
             
             // Call Decoder with modified F0
             let decoderInput = try MLDictionaryFeatureProvider(dictionary: [
@@ -370,12 +489,12 @@ public class TTSModel {
             print("Decoder s shape: \(refAudioArray.shape)")
             #endif
             
-            let decoderOutput = try monitor.measure(PerformanceMonitor.Module.decoder) {
+            let decoderOutput = try stage(PerformanceMonitor.Module.decoder) {
                 do {
                     #if DEBUG
                     print("Calling Decoder model...")
                     #endif
-                    let output = try decoder.prediction(from: decoderInput)
+                    let output = try outputBackings.prediction(decoder.get(), name: "Decoder", from: decoderInput, lease: lease)
                     #if DEBUG
                     print("Decoder model completed successfully")
                     #endif
@@ -393,6 +512,8 @@ public class TTSModel {
             
             let s = refAudioArray
             let F0_curve = modifiedF0
+            // Audio of padded frames is dropped
+            let sampleLimit = columns > indices.count ? indices.count * SynthesisCostModel.samplesPerFrame : nil
 
             // Generate audio using the generator
             #if DEBUG
@@ -401,12 +522,12 @@ public class TTSModel {
             print("Generator F0_curve shape: \(F0_curve.shape), total elements: \(F0_curve.count)")
             #endif
             
-            let audio = try monitor.measure(PerformanceMonitor.Module.generator) {
+            let audio = try stage(PerformanceMonitor.Module.generator) {
                 do {
                     #if DEBUG
                     print("Calling Generator...")
                     #endif
-                    let output = try generator.generate(x: x, s: s, f0Curve: F0_curve)
+                    let output = try generator.generate(x: x, s: s, f0Curve: F0_curve, seed: seed, sampleLimit: sampleLimit, lease: lease, into: sink)
                     #if DEBUG
                     print("Generator completed successfully")
                     #endif
@@ -503,11 +624,15 @@ public class TTSModel {
     
     // MARK: - Style Vector Processing
     
-    private func splitStyleVector(_ refS: [Float]) -> (refAudio: [Float], style: [Float]) {
+    /// Halves of `refS` as views into the same buffer, no copies
+    private func splitStyleVector(_ refS: UnsafeBufferPointer<Float>) throws -> (refAudio: UnsafeBufferPointer<Float>, style: UnsafeBufferPointer<Float>) {
+        guard refS.count == 256 else {
+            throw TTSError.invalidInput("Style vector should have 256 elements, got \(refS.count)")
+        }
         // ref_s[:, :128] - first 128 elements for reference audio
         // ref_s[:, 128:] - last 128 elements for style
-        let refAudio = Array(refS.prefix(128))
-        let style = Array(refS.suffix(128))
+        let refAudio = UnsafeBufferPointer(rebasing: refS[0..<128])
+        let style = UnsafeBufferPointer(rebasing: refS[128..<256])
         return (refAudio, style)
     }
     
@@ -533,125 +658,19 @@ public class TTSModel {
         return indices
     }
     
-    private func createAlignmentMatrix(indices: [Int], seqLen: Int) throws -> MLMultiArray {
-        // Create alignment matrix of shape [1, seqLen, totalDuration]
-        let totalDuration = indices.count
-        let alignmentMatrix = try MLMultiArray(shape: [1, NSNumber(value: seqLen), NSNumber(value: totalDuration)], dataType: .float32)
-        
-        // Initialize with zeros
-        let dataPointer = alignmentMatrix.dataPointer.bindMemory(to: Float32.self, capacity: alignmentMatrix.count)
-        for i in 0..<alignmentMatrix.count {
-            dataPointer[i] = 0.0
-        }
-        
-        // Set 1s at alignment positions
-        // pred_aln_trg[indices[i], i] = 1
-        for (i, index) in indices.enumerated() {
-            alignmentMatrix[[0, index as NSNumber, i as NSNumber]] = NSNumber(value: 1.0)
-        }
-        
-        return alignmentMatrix
-    }
-    
-    private func applyAlignment(d: MLMultiArray, alignmentMatrix: MLMultiArray) throws -> MLMultiArray {
-        // In Python: en = d.transpose(-1, -2) @ pred_aln_trg
-        // d shape: [1, seqLen, hiddenDim] needs to be transposed to [1, hiddenDim, seqLen]
-        // alignmentMatrix shape: [1, seqLen, totalDuration]
-        // Result should be: [1, hiddenDim, totalDuration]
-        
-        let seqLen = d.shape[1].intValue
-        let hiddenDim = d.shape[2].intValue
-        let totalDuration = alignmentMatrix.shape[2].intValue
-        
-        // First transpose d from [1, seqLen, hiddenDim] to [1, hiddenDim, seqLen]
-        let dTransposed = try transposeLastTwoDimensions(d)
-        
-        // Create result array
-        let result = try MLMultiArray(shape: [1, NSNumber(value: hiddenDim), NSNumber(value: totalDuration)], dataType: .float32)
-        
-        // Get data pointers
-        let dPointer = dTransposed.dataPointer.bindMemory(to: Float32.self, capacity: dTransposed.count)
-        let alignPointer = alignmentMatrix.dataPointer.bindMemory(to: Float32.self, capacity: alignmentMatrix.count)
-        let resultPointer = result.dataPointer.bindMemory(to: Float32.self, capacity: result.count)
-        
-        // Perform matrix multiplication: dTransposed[hiddenDim x seqLen] @ alignmentMatrix[seqLen x totalDuration]
-        // Using BLAS gemm: C = alpha * A * B + beta * C
-        cblas_sgemm(
-            CblasRowMajor,           // Row major storage
-            CblasNoTrans,            // Don't transpose A (dTransposed)
-            CblasNoTrans,            // Don't transpose B (alignmentMatrix)
-            Int32(hiddenDim),        // M: rows of A and C
-            Int32(totalDuration),    // N: columns of B and C
-            Int32(seqLen),           // K: columns of A, rows of B
-            1.0,                     // alpha
-            dPointer,                // A: dTransposed matrix
-            Int32(seqLen),           // Leading dimension of A
-            alignPointer,            // B: alignment matrix (skip batch dimension)
-            Int32(totalDuration),    // Leading dimension of B
-            0.0,                     // beta
-            resultPointer,           // C: result matrix
-            Int32(totalDuration)     // Leading dimension of C
-        )
-        
-        return result
-    }
-    
-    private func applyAlignmentDirect(input: MLMultiArray, alignmentMatrix: MLMultiArray) throws -> MLMultiArray {
-        // Direct matrix multiplication without transpose
-        // input shape: [1, hiddenDim, seqLen]
-        // alignmentMatrix shape: [1, seqLen, totalDuration]
-        // Result should be: [1, hiddenDim, totalDuration]
-        
-        let hiddenDim = input.shape[1].intValue
-        let seqLen = input.shape[2].intValue
-        let totalDuration = alignmentMatrix.shape[2].intValue
-        
-        // Create result array
-        let result = try MLMultiArray(shape: [1, NSNumber(value: hiddenDim), NSNumber(value: totalDuration)], dataType: .float32)
-        
-        // Get data pointers
-        let inputPointer = input.dataPointer.bindMemory(to: Float32.self, capacity: input.count)
-        let alignPointer = alignmentMatrix.dataPointer.bindMemory(to: Float32.self, capacity: alignmentMatrix.count)
+    /// Multiplies `input` by the one-hot alignment matrix `pred_aln_trg` as a column gather.
+    ///
+    /// Column `i` of the result is column `indices[i]` of `input`, so neither the
+    /// `[seqLen, frames]` alignment matrix nor a transposed copy of `input` is built.
+    /// - Parameters:
+    ///   - input: `[hiddenDim, seqLen]`, any strides
+    ///   - columns: Frames of the result, at least `indices.count`; extra columns stay zero
+    /// - Returns: Contiguous `[1, hiddenDim, columns]` array
+    private func align(_ input: MatrixView, indices: [Int], columns: Int) throws -> MLMultiArray {
+        let totalDuration = max(columns, indices.count)
+        let result = try MLMultiArray(shape: [1, NSNumber(value: input.rows), NSNumber(value: totalDuration)], dataType: .float32)
         let resultPointer = result.dataPointer.bindMemory(to: Float32.self, capacity: result.count)
-        
-        // Perform matrix multiplication: input[hiddenDim x seqLen] @ alignmentMatrix[seqLen x totalDuration]
-        cblas_sgemm(
-            CblasRowMajor,           // Row major storage
-            CblasNoTrans,            // Don't transpose A (input)
-            CblasNoTrans,            // Don't transpose B (alignmentMatrix)
-            Int32(hiddenDim),        // M: rows of A and C
-            Int32(totalDuration),    // N: columns of B and C
-            Int32(seqLen),           // K: columns of A, rows of B
-            1.0,                     // alpha
-            inputPointer,            // A: input matrix
-            Int32(seqLen),           // Leading dimension of A
-            alignPointer,            // B: alignment matrix
-            Int32(totalDuration),    // Leading dimension of B
-            0.0,                     // beta
-            resultPointer,           // C: result matrix
-            Int32(totalDuration)     // Leading dimension of C
-        )
-        
+        input.gatherColumns(indices, outputColumns: totalDuration, into: resultPointer)
         return result
     }
-    
-    // MARK: - Tensor Operations
-    
-    /// Optimized transpose using vDSP
-    private func transposeLastTwoDimensions(_ array: MLMultiArray) throws -> MLMultiArray {
-        let batch = array.shape[0].intValue
-        let dim1 = array.shape[1].intValue
-        let dim2 = array.shape[2].intValue
-        
-        let transposed = try MLMultiArray(shape: [NSNumber(value: batch), NSNumber(value: dim2), NSNumber(value: dim1)],
-                                         dataType: array.dataType)
-        
-        let sourcePointer = array.dataPointer.bindMemory(to: Float32.self, capacity: array.count)
-        let destPointer = transposed.dataPointer.bindMemory(to: Float32.self, capacity: transposed.count)
-        
-        // Use vDSP_mtrans for matrix transpose
-        vDSP_mtrans(sourcePointer, 1, destPointer, 1, vDSP_Length(dim2), vDSP_Length(dim1))
-        
-        return transposed
-    }
 }
@@ -0,0 +1,119 @@
+import Foundation
+import CoreML
+
+/// Loads the acoustic model stack once and hands out per-language pipelines that share it.
+///
+/// Only the front end differs between languages: G2P and the vocabulary
+/// tokenizer. Switching between `.englishUS` and `.englishGB` therefore costs
+/// a lexicon load instead of ten Core ML model loads, and all pipelines keep
+/// a single copy of the weights in memory.
+public final class TTSModelRegistry: @unchecked Sendable {
+
+    public struct Statistics: Sendable {
+        /// `TTSModel` loads, at most one per registry
+        public let modelLoads: Int
+        public let modelLoadSeconds: TimeInterval
+        /// Front ends built
+        public let pipelinesCreated: Int
+        /// `pipeline(for:)` calls answered from the cache
+        public let pipelineHits: Int
+        /// Seconds of the last front-end build, the cost of a language switch
+        public let lastPipelineSeconds: TimeInterval
+    }
+
+    public let modelPath: URL
+    public let vocabURL: URL
+    public let postaggerModelURL: URL
+    public let configuration: MLModelConfiguration
+    public let residency: ModelResidencyPolicy
+
+    private let lock = NSLock()
+    private var model: TTSModel?
+    private var pipelines: [Language: TTSPipeline] = [:]
+    private var modelLoads = 0
+    private var modelLoadSeconds: TimeInterval = 0
+    private var pipelinesCreated = 0
+    private var pipelineHits = 0
+    private var lastPipelineSeconds: TimeInterval = 0
+
+    /// - Parameter residency: Residency of the shared model's sub-models and of each pipeline's POS tagger
+    public init(modelPath: URL, vocabURL: URL, postaggerModelURL: URL, configuration: MLModelConfiguration = MLModelConfiguration(), residency: ModelResidencyPolicy = .resident) {
+        self.modelPath = modelPath
+        self.vocabURL = vocabURL
+        self.postaggerModelURL = postaggerModelURL
+        self.configuration = configuration
+        self.residency = residency
+    }
+
+    /// The shared model, loaded on first use
+    public func sharedModel() throws -> TTSModel {
+        lock.lock()
+        defer { lock.unlock() }
+        return try loadModel()
+    }
+
+    /// Pipeline for `language`, built once over the shared model
+    /// - Parameter g2p: External G2P for languages without a built-in one; only used when the pipeline is created
+    public func pipeline(for language: Language, g2p: G2P? = nil) throws -> TTSPipeline {
+        lock.lock()
+        defer { lock.unlock() }
+        if let pipeline = pipelines[language] {
+            pipelineHits += 1
+            return pipeline
+        }
+
+        let model = try loadModel()
+        let start = DispatchTime.now().uptimeNanoseconds
+        let pipeline = try TTSPipeline(
+            model: model,
+            modelPath: modelPath,
+            vocabURL: vocabURL,
+            postaggerModelURL: postaggerModelURL,
+            language: language,
+            g2p: g2p
+        )
+        lastPipelineSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        pipelinesCreated += 1
+        pipelines[language] = pipeline
+        return pipeline
+    }
+
+    /// Languages with a cached pipeline
+    public var loadedLanguages: [Language] {
+        lock.lock()
+        defer { lock.unlock() }
+        return Language.allCases.filter { pipelines[$0] != nil }
+    }
+
+    /// Drops the cached front ends; the model stays loaded
+    public func removePipelines(except kept: Language? = nil) {
+        lock.lock()
+        defer { lock.unlock() }
+        pipelines = pipelines.filter { $0.key == kept }
+    }
+
+    public func statistics() -> Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return Statistics(
+            modelLoads: modelLoads,
+            modelLoadSeconds: modelLoadSeconds,
+            pipelinesCreated: pipelinesCreated,
+            pipelineHits: pipelineHits,
+            lastPipelineSeconds: lastPipelineSeconds
+        )
+    }
+
+    /// Call with `lock` held
+    private func loadModel() throws -> TTSModel {
+        if let model = model {
+            return model
+        }
+        let start = DispatchTime.now().uptimeNanoseconds
+        let loaded = try TTSModel(modelPath: modelPath, configuration: configuration, residency: residency)
+        modelLoadSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        modelLoads += 1
+        model = loaded
+        return loaded
+    }
+}
@@ -0,0 +1,317 @@
+import Foundation
+
+/// When sub-models are loaded and unloaded
+public struct ModelResidencyPolicy: Sendable {
+    /// Defer each load to the first call that needs the model
+    public var loadOnFirstUse: Bool
+    /// Unload models unused for this long, `nil` keeps them
+    public var idleTimeout: TimeInterval?
+    /// Unload everything on a system memory warning; caches are dropped either way
+    public var unloadOnMemoryWarning: Bool
+
+    public init(loadOnFirstUse: Bool, idleTimeout: TimeInterval?, unloadOnMemoryWarning: Bool) {
+        self.loadOnFirstUse = loadOnFirstUse
+        self.idleTimeout = idleTimeout
+        self.unloadOnMemoryWarning = unloadOnMemoryWarning
+    }
+
+    /// Everything loaded up front and kept for the pipeline's lifetime
+    public static let resident = ModelResidencyPolicy(loadOnFirstUse: false, idleTimeout: nil, unloadOnMemoryWarning: false)
+    /// Loaded on demand, unloaded after five idle minutes or on memory pressure
+    public static let onDemand = ModelResidencyPolicy(loadOnFirstUse: true, idleTimeout: 300, unloadOnMemoryWarning: true)
+}
+
+/// Tracks lazily loaded models, unloads idle ones and reacts to memory pressure.
+///
+/// Each model is a `ResidentResource` owned by its user (`TTSModel`,
+/// `Generator`, `G2PEn`); the manager only keeps weak references, so
+/// dropping a pipeline also drops its entries. Resident bytes are the size
+/// of the compiled bundle on disk, a close proxy for the weights Core ML maps.
+/// `prefetch` reloads evicted models in parallel ahead of an expected request.
+/// Caches kept next to the models (pooled output buffers) register a purge
+/// handler; it runs on every memory warning and in `unloadAll`.
+public final class ModelResidencyManager: @unchecked Sendable {
+
+    public struct Entry: Sendable {
+        public let name: String
+        public let isResident: Bool
+        /// Bundle size, counted while resident
+        public let bytes: Int
+        public let loads: Int
+        public let evictions: Int
+        /// Duration of the last load
+        public let lastLoadSeconds: TimeInterval
+        /// Time since the last use, 0 if never used
+        public let idleSeconds: TimeInterval
+    }
+
+    public let policy: ModelResidencyPolicy
+
+    private let lock = NSLock()
+    private var entries: [WeakEntry] = []
+    private var purgeHandlers: [@Sendable () -> Void] = []
+    private let queue = DispatchQueue(label: "com.ios-tts.residency", qos: .utility)
+    private var idleTimer: DispatchSourceTimer?
+    private var memoryPressure: DispatchSourceMemoryPressure?
+
+    private struct WeakEntry {
+        weak var entry: ResidencyTracked?
+    }
+
+    public init(policy: ModelResidencyPolicy = .resident) {
+        self.policy = policy
+
+        if let timeout = policy.idleTimeout {
+            let timer = DispatchSource.makeTimerSource(queue: queue)
+            let interval = max(timeout / 4, 1)
+            timer.schedule(deadline: .now() + interval, repeating: interval)
+            timer.setEventHandler { [weak self] in
+                self?.unloadIdle(for: timeout)
+            }
+            timer.resume()
+            idleTimer = timer
+        }
+        let source = DispatchSource.makeMemoryPressureSource(eventMask: [.warning, .critical], queue: queue)
+        source.setEventHandler { [weak self] in
+            self?.handleMemoryWarning()
+        }
+        source.resume()
+        memoryPressure = source
+    }
+
+    deinit {
+        idleTimer?.cancel()
+        memoryPressure?.cancel()
+    }
+
+    /// Creates a resource loaded by `loader` on first use (or right away by `load`)
+    /// - Parameter bytes: Resident size estimate, see `bundleBytes(at:)`
+    func register<Resource>(name: String, bytes: Int, loader: @escaping () throws -> Resource) -> ResidentResource<Resource> {
+        let resource = ResidentResource(name: name, bytes: bytes, loader: loader)
+        lock.lock()
+        entries.removeAll { $0.entry == nil }
+        entries.append(WeakEntry(entry: resource))
+        lock.unlock()
+        return resource
+    }
+
+    /// Runs `handler` on memory warnings and in `unloadAll`, to drop caches that outlive requests
+    func addPurgeHandler(_ handler: @escaping @Sendable () -> Void) {
+        lock.lock()
+        purgeHandlers.append(handler)
+        lock.unlock()
+    }
+
+    /// Loads `resources` in parallel
+    /// - Throws: The error of the first resource (in order) that failed
+    func load(_ resources: [ResidencyTracked]) throws {
+        let errors = ErrorSlots(count: resources.count)
+        DispatchQueue.concurrentPerform(iterations: resources.count) { index in
+            do {
+                try resources[index].prefetch()
+            } catch {
+                errors.set(error, at: index)
+            }
+        }
+        if let error = errors.first {
+            throw error
+        }
+    }
+
+    /// Starts loading unloaded models in the background, e.g. when the user starts typing.
+    /// - Parameter names: Models to load, all tracked ones by default
+    public func prefetch(_ names: Set<String>? = nil) {
+        let pending = tracked().filter { !$0.isResident && (names?.contains($0.name) ?? true) }
+        guard !pending.isEmpty else { return }
+        queue.async {
+            // Errors surface again on the first real use
+            try? self.load(pending)
+        }
+    }
+
+    /// Unloads models not used for `interval` seconds
+    /// - Returns: Bytes released
+    @discardableResult
+    public func unloadIdle(for interval: TimeInterval) -> Int {
+        return tracked().reduce(0) { $0 + $1.evict(idleFor: interval) }
+    }
+
+    /// Unloads every model and drops caches; the next use reloads it
+    /// - Returns: Bytes released by the models
+    @discardableResult
+    public func unloadAll() -> Int {
+        purgeCaches()
+        return tracked().reduce(0) { $0 + $1.evict(idleFor: 0) }
+    }
+
+    /// Drops caches, and with `unloadOnMemoryWarning` every model too
+    func handleMemoryWarning() {
+        if policy.unloadOnMemoryWarning {
+            unloadAll()
+        } else {
+            purgeCaches()
+        }
+    }
+
+    public func report() -> [Entry] {
+        return tracked().map { $0.entry() }
+    }
+
+    /// Sum of `bytes` over resident models
+    public var residentBytes: Int {
+        return report().filter(\.isResident).reduce(0) { $0 + $1.bytes }
+    }
+
+    private func purgeCaches() {
+        lock.lock()
+        let handlers = purgeHandlers
+        lock.unlock()
+        handlers.forEach { $0() }
+    }
+
+    private func tracked() -> [ResidencyTracked] {
+        lock.lock()
+        defer { lock.unlock() }
+        entries.removeAll { $0.entry == nil }
+        return entries.compactMap(\.entry)
+    }
+
+    /// Total size of the files under `url`, the resident estimate for a model bundle
+    public static func bundleBytes(at url: URL) -> Int {
+        guard let enumerator = FileManager.default.enumerator(at: url, includingPropertiesForKeys: [.fileSizeKey, .isRegularFileKey]) else {
+            return 0
+        }
+        var total = 0
+        for case let file as URL in enumerator {
+            guard let values = try? file.resourceValues(forKeys: [.fileSizeKey, .isRegularFileKey]), values.isRegularFile == true else { continue }
+            total += values.fileSize ?? 0
+        }
+        return total
+    }
+
+    private final class ErrorSlots: @unchecked Sendable {
+        private let lock = NSLock()
+        private var errors: [Error?]
+
+        init(count: Int) {
+            errors = Array(repeating: nil, count: count)
+        }
+
+        func set(_ error: Error, at index: Int) {
+            lock.lock()
+            errors[index] = error
+            lock.unlock()
+        }
+
+        var first: Error? {
+            lock.lock()
+            defer { lock.unlock() }
+            return errors.compactMap { $0 }.first
+        }
+    }
+}
+
+/// Type-erased view of a `ResidentResource` for the manager
+protocol ResidencyTracked: AnyObject {
+    var name: String { get }
+    var isResident: Bool { get }
+    func prefetch() throws
+    /// - Returns: Bytes released, 0 if the resource was not resident or was used more recently
+    func evict(idleFor interval: TimeInterval) -> Int
+    func entry() -> ModelResidencyManager.Entry
+}
+
+/// A model (or any heavy object) that is loaded on first use and can be unloaded.
+///
+/// Callers keep the returned instance only for the duration of one call, so an
+/// eviction during inference frees the memory once that call finishes.
+final class ResidentResource<Resource>: ResidencyTracked, @unchecked Sendable {
+    let name: String
+    private let bytes: Int
+    /// `nil` for resources handed in already loaded; those are never evicted
+    private let loader: (() throws -> Resource)?
+
+    private let lock = NSLock()
+    private var resource: Resource?
+    private var lastUse: UInt64 = 0
+    private var loads = 0
+    private var evictions = 0
+    private var lastLoadSeconds: TimeInterval = 0
+
+    init(name: String, bytes: Int, loader: @escaping () throws -> Resource) {
+        self.name = name
+        self.bytes = bytes
+        self.loader = loader
+    }
+
+    /// Wraps an already loaded resource that stays resident
+    init(name: String, resident: Resource) {
+        self.name = name
+        self.bytes = 0
+        self.loader = nil
+        self.resource = resident
+    }
+
+    /// The resource, loading it first if needed
+    func get() throws -> Resource {
+        lock.lock()
+        defer { lock.unlock() }
+        lastUse = DispatchTime.now().uptimeNanoseconds
+        return try loadLocked()
+    }
+
+    var isResident: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return resource != nil
+    }
+
+    func prefetch() throws {
+        lock.lock()
+        defer { lock.unlock() }
+        _ = try loadLocked()
+    }
+
+    func evict(idleFor interval: TimeInterval) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        guard loader != nil, resource != nil else { return 0 }
+        let idle = Double(DispatchTime.now().uptimeNanoseconds - lastUse) / 1e9
+        guard idle >= interval else { return 0 }
+        resource = nil
+        evictions += 1
+        return bytes
+    }
+
+    func entry() -> ModelResidencyManager.Entry {
+        lock.lock()
+        defer { lock.unlock() }
+        return ModelResidencyManager.Entry(
+            name: name,
+            isResident: resource != nil,
+            bytes: bytes,
+            loads: loads,
+            evictions: evictions,
+            lastLoadSeconds: lastLoadSeconds,
+            idleSeconds: lastUse == 0 ? 0 : Double(DispatchTime.now().uptimeNanoseconds - lastUse) / 1e9
+        )
+    }
+
+    /// Call with `lock` held
+    private func loadLocked() throws -> Resource {
+        if let resource = resource {
+            return resource
+        }
+        guard let loader = loader else {
+            throw TTSError.modelNotFound("\(name) has no loader")
+        }
+        let start = DispatchTime.now().uptimeNanoseconds
+        let loaded = try loader()
+        lastLoadSeconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1e9
+        loads += 1
+        resource = loaded
+        // A prefetched resource counts as used when it lands, so the idle timer gives it a full timeout
+        lastUse = DispatchTime.now().uptimeNanoseconds
+        return loaded
+    }
+}
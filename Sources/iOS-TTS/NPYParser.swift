@@ -13,7 +13,32 @@ public struct NPYParser {
         return try parseNPY(data: data)
     }
     
+    /// Maps a float32 `.npy` file instead of reading it; elements are read in place on demand
+    public static func mapArray(from url: URL) throws -> NPYMappedArray {
+        let data = try Data(contentsOf: url, options: .alwaysMapped)
+        let offset = try dataOffset(in: data)
+        // Format versions 1 and 2 align the data to 64 bytes, mapped files start on a page
+        guard offset % MemoryLayout<Float>.alignment == 0 else {
+            throw NPYError.invalidFormat("Data at offset \(offset) is not float32-aligned")
+        }
+        return NPYMappedArray(data: data, offset: offset, count: (data.count - offset) / MemoryLayout<Float>.size)
+    }
+    
     private static func parseNPY(data: Data) throws -> [Float] {
+        let headerEndIndex = try dataOffset(in: data)
+        let byteCount = data.count - headerEndIndex
+        
+        // Convert bytes to Float32 array (assuming little endian float32)
+        let floatCount = byteCount / 4
+        
+        // One bulk copy, no per-element appends
+        return [Float](unsafeUninitializedCapacity: floatCount) { buffer, initializedCount in
+            initializedCount = data.copyBytes(to: buffer, from: headerEndIndex..<data.count) / MemoryLayout<Float>.size
+        }
+    }
+    
+    /// Validates the header and returns where the array data starts
+    private static func dataOffset(in data: Data) throws -> Int {
         // NPY file format:
         // - Magic string: "\x93NUMPY" (6 bytes)
         // - Major version: 1 byte
@@ -35,17 +60,13 @@ public struct NPYParser {
         
         // Read version
         let majorVersion = data[6]
-        let minorVersion = data[7]
         
         guard majorVersion == 1 else {
             throw NPYError.unsupportedVersion("Unsupported major version: \(majorVersion)")
         }
         
         // Read header length (little endian)
-        let headerLength = data.withUnsafeBytes { bytes in
-            let headerLengthBytes = bytes.bindMemory(to: UInt16.self)
-            return UInt16(littleEndian: headerLengthBytes[4]) // bytes 8-9
-        }
+        let headerLength = UInt16(data[8]) | UInt16(data[9]) << 8
         
         // Skip header for now and go directly to data
         // We assume it's float32 array with shape that we can determine from data size
@@ -55,27 +76,37 @@ public struct NPYParser {
             throw NPYError.invalidFormat("Header extends beyond file")
         }
         
-        let arrayData = data.subdata(in: headerEndIndex..<data.count)
-        
-        // Convert bytes to Float32 array (assuming little endian float32)
-        let floatCount = arrayData.count / 4
-        guard arrayData.count % 4 == 0 else {
+        guard (data.count - headerEndIndex) % 4 == 0 else {
             throw NPYError.invalidFormat("Data size not divisible by 4 (not float32)")
         }
         
-        var floats: [Float] = []
-        floats.reserveCapacity(floatCount)
-        
-        arrayData.withUnsafeBytes { bytes in
-            let floatBytes = bytes.bindMemory(to: Float32.self)
-            for i in 0..<floatCount {
-                // Read float value (assuming little endian)
-                let value = floatBytes[i]
-                floats.append(Float(value))
-            }
+        return headerEndIndex
+    }
+}
+
+/// Float32 `.npy` array backed by a memory-mapped file.
+///
+/// Only the pages that are read get loaded, and they can be dropped by the
+/// system under memory pressure without any copy of ours to free.
+public struct NPYMappedArray: Sendable {
+    private let data: Data
+    private let offset: Int
+    /// Number of float32 elements
+    public let count: Int
+    
+    init(data: Data, offset: Int, count: Int) {
+        self.data = data
+        self.offset = offset
+        self.count = count
+    }
+    
+    /// Calls `body` with elements `range`, read in place from the mapping
+    public func withElements<R>(in range: Range<Int>, _ body: (UnsafeBufferPointer<Float>) throws -> R) rethrows -> R {
+        precondition(range.lowerBound >= 0 && range.upperBound <= count, "Range \(range) outside 0..<\(count)")
+        return try data.withUnsafeBytes { raw in
+            let floats = raw.baseAddress!.advanced(by: offset).assumingMemoryBound(to: Float.self)
+            return try body(UnsafeBufferPointer(start: floats + range.lowerBound, count: range.count))
         }
-        
-        return floats
     }
 }
 
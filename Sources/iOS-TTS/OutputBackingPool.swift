@@ -0,0 +1,256 @@
+import Foundation
+import CoreML
+
+/// Output buffer reuse across predictions
+public struct OutputBackingStatistics: Sendable {
+    /// Requests (`TTSModel.infer` or standalone `Generator.generate` calls) that used the pool
+    public let requests: Int
+    /// Outputs written into a pooled buffer
+    public let hits: Int
+    /// Outputs that needed a new buffer
+    public let misses: Int
+    /// Predictions retried without backings after Core ML rejected them
+    public let fallbacks: Int
+    /// Output bytes Core ML did not have to allocate
+    public let reusedBytes: Int
+    /// Bytes of the last request served from the pool
+    public let lastRequestReusedBytes: Int
+    /// Bytes held by idle buffers
+    public let pooledBytes: Int
+
+    public var reusedBytesPerRequest: Double {
+        return requests == 0 ? 0 : Double(reusedBytes) / Double(requests)
+    }
+}
+
+/// Shape and element type a pooled buffer can be reused for
+private struct BufferKey: Hashable {
+    let shape: [Int]
+    let dataType: Int
+}
+
+/// Preallocated `MLMultiArray`s passed to Core ML as `outputBackings`.
+///
+/// Core ML has no output shapes up front for the flexible-shape models, so
+/// the pool learns them: the first prediction for a given model and input
+/// shapes runs normally and records its output shapes, later ones get
+/// matching buffers. Buffers are contiguous, which is the layout the
+/// pointer-based code after each stage (transposes, alignment GEMMs, iSTFT)
+/// expects. A request holds its buffers in a `BackingLease` until it
+/// finishes, then they go back to the pool, least recently returned first
+/// out once `capacity` is exceeded. With `LengthBuckets` most requests
+/// repeat a few shapes and are served entirely from the pool.
+///
+/// Idle buffers are a cache: `purge` drops them, which `TTSModel` hooks to
+/// memory warnings and `ModelResidencyManager.unloadAll`. A model whose
+/// backend rejects backings runs without them for the next
+/// `retryInterval` requests, then gets another try.
+final class OutputBackingPool: @unchecked Sendable {
+
+    struct OutputSpec {
+        let name: String
+        let shape: [NSNumber]
+        let dataType: MLMultiArrayDataType
+    }
+
+    private struct FreeBuffer {
+        let key: BufferKey
+        let array: MLMultiArray
+        let bytes: Int
+        let returned: UInt64
+    }
+
+    /// Largest total of idle buffers
+    let capacity: Int
+    /// Requests a model runs without backings after its backend refused them
+    static let retryInterval = 100
+
+    private let lock = NSLock()
+    private var enabled = true
+    /// Output specs per model and input shapes
+    private var specs: [String: [OutputSpec]] = [:]
+    /// Models whose backend refused backings, with the request count to retry at
+    private var unsupported: [String: Int] = [:]
+    private var free: [FreeBuffer] = []
+    private var pooledBytes = 0
+    private var clock: UInt64 = 0
+
+    private var requests = 0
+    private var hits = 0
+    private var misses = 0
+    private var fallbacks = 0
+    private var reusedBytes = 0
+    private var lastRequestReusedBytes = 0
+
+    /// Learned signatures before the table is reset, it grows with every new shape
+    private static let maxSignatures = 512
+
+    init(capacity: Int = 64 * 1024 * 1024) {
+        self.capacity = capacity
+    }
+
+    /// Off: predictions allocate their own outputs, idle and returning buffers are dropped
+    var isEnabled: Bool {
+        get {
+            lock.lock()
+            defer { lock.unlock() }
+            return enabled
+        }
+        set {
+            lock.lock()
+            enabled = newValue
+            lock.unlock()
+            if !newValue {
+                purge()
+            }
+        }
+    }
+
+    /// Runs `model`, writing outputs into pooled buffers when their shapes are known
+    /// - Parameters:
+    ///   - name: Identifies the model, outputs are learned per name and input shapes
+    ///   - lease: Keeps the buffers until the request ends
+    func prediction(_ model: MLModel, name: String, from input: MLFeatureProvider, lease: BackingLease?) throws -> MLFeatureProvider {
+        guard let lease = lease else {
+            return try model.prediction(from: input)
+        }
+        let signature = OutputBackingPool.signature(name: name, input: input)
+
+        lock.lock()
+        let isEnabled = enabled
+        let isUnsupported = unsupported[name].map { requests < $0 } ?? false
+        let outputs = specs[signature]
+        lock.unlock()
+
+        guard isEnabled, !isUnsupported else {
+            return try model.prediction(from: input)
+        }
+        guard let outputs = outputs else {
+            let output = try model.prediction(from: input)
+            learn(signature, from: output)
+            return output
+        }
+
+        let options = MLPredictionOptions()
+        options.outputBackings = try takeBuffers(for: outputs, lease: lease)
+        do {
+            return try model.prediction(from: input, options: options)
+        } catch {
+            // Not every backend takes backings for every output; run without for a while
+            lock.lock()
+            unsupported[name] = requests + OutputBackingPool.retryInterval
+            fallbacks += 1
+            lock.unlock()
+            return try model.prediction(from: input)
+        }
+    }
+
+    /// A buffer per output, pooled when one of the same shape is idle; the lease holds them
+    func takeBuffers(for outputs: [OutputSpec], lease: BackingLease) throws -> [String: Any] {
+        lock.lock()
+        defer { lock.unlock() }
+        var backings: [String: Any] = [:]
+        for spec in outputs {
+            let key = BufferKey(shape: spec.shape.map(\.intValue), dataType: spec.dataType.rawValue)
+            let bytes = key.shape.reduce(1, *) * OutputBackingPool.elementSize(spec.dataType)
+            let array: MLMultiArray
+            if let index = free.lastIndex(where: { $0.key == key }) {
+                let buffer = free.remove(at: index)
+                pooledBytes -= buffer.bytes
+                hits += 1
+                lease.reusedBytes += bytes
+                array = buffer.array
+            } else {
+                misses += 1
+                array = try MLMultiArray(shape: spec.shape, dataType: spec.dataType)
+            }
+            lease.held.append((key, array, bytes))
+            backings[spec.name] = array
+        }
+        return backings
+    }
+
+    /// Returns the lease's buffers and records its savings
+    func finish(_ lease: BackingLease) {
+        let held = lease.held
+        lease.held.removeAll()
+        lock.lock()
+        defer { lock.unlock() }
+        requests += 1
+        reusedBytes += lease.reusedBytes
+        lastRequestReusedBytes = lease.reusedBytes
+        guard enabled else { return }
+        for buffer in held {
+            clock += 1
+            free.append(FreeBuffer(key: buffer.key, array: buffer.array, bytes: buffer.bytes, returned: clock))
+            pooledBytes += buffer.bytes
+        }
+        while pooledBytes > capacity, let oldest = free.indices.min(by: { free[$0].returned < free[$1].returned }) {
+            pooledBytes -= free.remove(at: oldest).bytes
+        }
+    }
+
+    /// Drops idle buffers and learned shapes; buffers of running requests return later as usual
+    func purge() {
+        lock.lock()
+        defer { lock.unlock() }
+        free.removeAll()
+        pooledBytes = 0
+        specs.removeAll()
+    }
+
+    func statistics() -> OutputBackingStatistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return OutputBackingStatistics(
+            requests: requests,
+            hits: hits,
+            misses: misses,
+            fallbacks: fallbacks,
+            reusedBytes: reusedBytes,
+            lastRequestReusedBytes: lastRequestReusedBytes,
+            pooledBytes: pooledBytes
+        )
+    }
+
+    private func learn(_ signature: String, from output: MLFeatureProvider) {
+        let outputs = output.featureNames.sorted().compactMap { name -> OutputSpec? in
+            guard let array = output.featureValue(for: name)?.multiArrayValue else { return nil }
+            return OutputSpec(name: name, shape: array.shape, dataType: array.dataType)
+        }
+        lock.lock()
+        defer { lock.unlock() }
+        if specs.count >= OutputBackingPool.maxSignatures {
+            specs.removeAll()
+        }
+        specs[signature] = outputs
+    }
+
+    /// Model name plus the shape of every multi-array input
+    private static func signature(name: String, input: MLFeatureProvider) -> String {
+        var signature = name
+        for feature in input.featureNames.sorted() {
+            guard let array = input.featureValue(for: feature)?.multiArrayValue else { continue }
+            signature += "|\(feature):" + array.shape.map { $0.stringValue }.joined(separator: "x")
+        }
+        return signature
+    }
+
+    private static func elementSize(_ dataType: MLMultiArrayDataType) -> Int {
+        switch dataType {
+        case .double:
+            return 8
+        case .float16:
+            return 2
+        default:
+            return 4
+        }
+    }
+}
+
+/// Pooled buffers held by one request; outputs stay valid until `OutputBackingPool.finish`
+final class BackingLease {
+    /// Bytes served from idle buffers
+    fileprivate(set) var reusedBytes = 0
+    fileprivate var held: [(key: BufferKey, array: MLMultiArray, bytes: Int)] = []
+}
@@ -3,6 +3,7 @@ import Foundation
 /// Performance monitor for measuring execution time between TTS pipeline modules
 public final class PerformanceMonitor: @unchecked Sendable {
     private var measurements: [String: TimeInterval] = [:]
+    private var bytesMoved: [String: Int] = [:]
     private var startTimes: [String: Date] = [:]
     private let queue = DispatchQueue(label: "com.ios-tts.performance", attributes: .concurrent)
     
@@ -49,8 +50,9 @@ public final class PerformanceMonitor: @unchecked Sendable {
     public func measure<T>(_ module: String, operation: () throws -> T) rethrows -> T {
         guard isEnabled else { return try operation() }
         
-        startMeasurement(module)
-        defer { endMeasurement(module) }
+        // Start time stays local, so concurrent measurements of one module don't overwrite each other
+        let startTime = Date()
+        defer { record(module, since: startTime) }
         return try operation()
     }
     
@@ -63,11 +65,38 @@ public final class PerformanceMonitor: @unchecked Sendable {
     public func measureAsync<T>(_ module: String, operation: () async throws -> T) async rethrows -> T {
         guard isEnabled else { return try await operation() }
         
-        startMeasurement(module)
-        defer { endMeasurement(module) }
+        let startTime = Date()
+        defer { record(module, since: startTime) }
         return try await operation()
     }
     
+    private func record(_ module: String, since startTime: Date) {
+        let duration = Date().timeIntervalSince(startTime)
+        queue.async(flags: .barrier) {
+            self.measurements[module] = duration
+        }
+    }
+    
+    /// Record the bytes a module copied in its latest run (tensor copies, transposes, gathers)
+    /// - Parameters:
+    ///   - bytes: Bytes written
+    ///   - module: The name of the module
+    public func recordBytesMoved(_ bytes: Int, for module: String) {
+        guard isEnabled else { return }
+        
+        queue.async(flags: .barrier) {
+            self.bytesMoved[module] = bytes
+        }
+    }
+    
+    /// Get bytes moved per module
+    /// - Returns: Dictionary of module names to bytes written in their latest run
+    public func getBytesMoved() -> [String: Int] {
+        queue.sync {
+            return bytesMoved
+        }
+    }
+    
     /// Get all measurements
     /// - Returns: Dictionary of module names to execution times in seconds
     public func getAllMeasurements() -> [String: TimeInterval] {
@@ -89,6 +118,7 @@ public final class PerformanceMonitor: @unchecked Sendable {
     public func clearMeasurements() {
         queue.async(flags: .barrier) {
             self.measurements.removeAll()
+            self.bytesMoved.removeAll()
             self.startTimes.removeAll()
         }
     }
@@ -125,6 +155,16 @@ public final class PerformanceMonitor: @unchecked Sendable {
         let totalSecStr = String(format: "%.3f", totalTime).padding(toLength: 10, withPad: " ", startingAt: 0)
         report += "\(totalName) | \(totalMsStr) | \(totalSecStr)\n"
         
+        let bytesMoved = getBytesMoved()
+        if !bytesMoved.isEmpty {
+            report += "\n" + "Module".padding(toLength: 30, withPad: " ", startingAt: 0) + " | Bytes moved\n"
+            report += String(repeating: "-", count: 60) + "\n"
+            for (module, bytes) in bytesMoved.sorted(by: { $0.key < $1.key }) {
+                let moduleName = module.padding(toLength: 30, withPad: " ", startingAt: 0)
+                report += "\(moduleName) | \(ByteCountFormatter.string(fromByteCount: Int64(bytes), countStyle: .memory))\n"
+            }
+        }
+        
         return report
     }
     
@@ -0,0 +1,159 @@
+import Foundation
+import CoreML
+
+/// Compiled phoneme tokenizer mapping Unicode scalars to vocabulary ids.
+///
+/// Built once from the `*_vocab.json` dictionary. Scalars up to the largest
+/// single-scalar vocab key are resolved through a dense table; anything above
+/// that range (or any scalar absent from the vocab) maps to the `<unk>` id.
+public struct PhonemeTokenizer: Sendable {
+    /// Id written for scalars that are not in the vocabulary
+    public let unknownId: Int32
+    /// Id written at the start and the end of every sequence
+    public let padId: Int32
+
+    private let table: [Int32]
+    private let statistics: Statistics
+
+    /// Builds the dense table from a vocab dictionary (`phoneme -> id`)
+    public init(vocab: [String: Int]) {
+        self.unknownId = Int32(vocab["<unk>"] ?? vocab["[UNK]"] ?? 1)
+        self.padId = Int32(vocab["<pad>"] ?? vocab["[PAD]"] ?? 0)
+
+        // Only single-scalar keys can ever match, the lookup is per scalar
+        var singleScalarKeys: [(UInt32, Int32)] = []
+        for (key, id) in vocab {
+            let scalars = key.unicodeScalars
+            if scalars.count == 1, let scalar = scalars.first {
+                singleScalarKeys.append((scalar.value, Int32(id)))
+            }
+        }
+
+        let upperBound = Int(singleScalarKeys.map { $0.0 }.max() ?? 0) + 1
+        var table = [Int32](repeating: -1, count: upperBound)
+        for (scalar, id) in singleScalarKeys {
+            table[Int(scalar)] = id
+        }
+
+        self.table = table
+        self.statistics = Statistics()
+    }
+
+    /// Number of ids `encode` produces for `phonemes`, including the two pads
+    public func tokenCount(for phonemes: String) -> Int {
+        return phonemes.unicodeScalars.count + 2
+    }
+
+    /// Id for a single scalar, `nil` if it is not in the vocabulary
+    @inline(__always)
+    public func id(for scalar: Unicode.Scalar) -> Int32? {
+        let value = Int(scalar.value)
+        guard value < table.count else { return nil }
+        let id = table[value]
+        return id >= 0 ? id : nil
+    }
+
+    /// Writes `[pad] + ids + [pad]` into `buffer`, converting ids with `convert`.
+    /// - Returns: Number of ids written
+    @discardableResult
+    public func encode<T>(_ phonemes: String, into buffer: UnsafeMutableBufferPointer<T>, convert: (Int32) -> T) -> Int {
+        let count = tokenCount(for: phonemes)
+        precondition(buffer.count >= count, "Buffer too small for \(count) token ids")
+
+        var unknown: [Unicode.Scalar: Int] = [:]
+        buffer[0] = convert(padId)
+        var position = 1
+        table.withUnsafeBufferPointer { table in
+            for scalar in phonemes.unicodeScalars {
+                let value = Int(scalar.value)
+                let id = value < table.count ? table[value] : -1
+                if id >= 0 {
+                    buffer[position] = convert(id)
+                } else {
+                    buffer[position] = convert(unknownId)
+                    unknown[scalar, default: 0] += 1
+                }
+                position += 1
+            }
+        }
+        buffer[position] = convert(padId)
+
+        statistics.record(tokens: count - 2, unknown: unknown)
+        return count
+    }
+
+    /// Encodes into a Swift array of ids (with pads)
+    public func encode(_ phonemes: String) -> [Int] {
+        var ids = [Int](repeating: 0, count: tokenCount(for: phonemes))
+        ids.withUnsafeMutableBufferPointer { buffer in
+            _ = encode(phonemes, into: buffer) { Int($0) }
+        }
+        return ids
+    }
+
+    /// Encodes directly into a `[1, count]` float32 `input_ids` array for the model
+    /// - Parameter length: Array length; ids past the sequence are `padId` and must be masked out
+    public func makeInputIdsArray(for phonemes: String, length: Int? = nil) throws -> MLMultiArray {
+        let count = tokenCount(for: phonemes)
+        let total = max(length ?? count, count)
+        let array = try MLMultiArray(shape: [1, NSNumber(value: total)], dataType: .float32)
+        let pointer = array.dataPointer.bindMemory(to: Float32.self, capacity: total)
+        encode(phonemes, into: UnsafeMutableBufferPointer(start: pointer, count: count)) { Float32($0) }
+        (pointer + count).initialize(repeating: Float32(padId), count: total - count)
+        return array
+    }
+
+    // MARK: - Statistics
+
+    /// Snapshot of tokenizer usage since the last reset
+    public struct Report: Sendable {
+        public let tokens: Int
+        public let unknownTokens: Int
+        /// Unknown scalars and how often they were seen
+        public let unknownScalars: [Unicode.Scalar: Int]
+
+        public var unknownRate: Double {
+            return tokens == 0 ? 0 : Double(unknownTokens) / Double(tokens)
+        }
+    }
+
+    public var report: Report {
+        return statistics.snapshot()
+    }
+
+    public func resetStatistics() {
+        statistics.reset()
+    }
+
+    /// Shared counters; copies of the tokenizer report into the same instance
+    private final class Statistics: @unchecked Sendable {
+        private var tokens = 0
+        private var unknownTokens = 0
+        private var unknownScalars: [Unicode.Scalar: Int] = [:]
+        private let queue = DispatchQueue(label: "com.ios-tts.tokenizer-stats", attributes: .concurrent)
+
+        func record(tokens: Int, unknown: [Unicode.Scalar: Int]) {
+            queue.async(flags: .barrier) {
+                self.tokens += tokens
+                for (scalar, count) in unknown {
+                    self.unknownTokens += count
+                    self.unknownScalars[scalar, default: 0] += count
+                }
+            }
+        }
+
+        func snapshot() -> Report {
+            queue.sync {
+                Report(tokens: tokens, unknownTokens: unknownTokens, unknownScalars: unknownScalars)
+            }
+        }
+
+        func reset() {
+            queue.async(flags: .barrier) {
+                self.tokens = 0
+                self.unknownTokens = 0
+                self.unknownScalars.removeAll()
+            }
+        }
+    }
+}
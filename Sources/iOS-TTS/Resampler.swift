@@ -0,0 +1,248 @@
+import Foundation
+import Accelerate
+
+/// Streaming polyphase resampler for the rational ratio `outputRate / inputRate`.
+///
+/// The ratio is reduced to `L / M` (24 kHz -> 16 kHz is 2/3, -> 44.1 kHz is
+/// 147/80). A Kaiser-windowed sinc low-pass for the virtual `L`-times
+/// upsampled signal is designed once per ratio and split into `L` phase
+/// banks, each stored reversed so an output sample is one `vDSP_dotpr` over
+/// the input history. Banks are immutable and shared by every resampler with
+/// the same `L / M`, so creating one per stream costs no filter design.
+/// Input can arrive in chunks of any size: the last `taps - 1` samples and
+/// the phase position carry over, and `flush` drains the filter delay so the
+/// output is aligned with the input and has `ceil(inputCount * L / M)` samples.
+public struct PolyphaseResampler {
+    public let inputRate: Int
+    public let outputRate: Int
+    /// Upsampling factor
+    public let interpolation: Int
+    /// Downsampling factor
+    public let decimation: Int
+    /// Taps per phase
+    public let tapsPerPhase: Int
+
+    /// Upper bound for `interpolation`, keeps the filter bank small
+    public static let maxInterpolation = 1024
+
+    private let bank: FilterBank
+    /// Filter delay in upsampled samples
+    private var delay: Int {
+        return bank.delay
+    }
+
+    /// Input history: `tapsPerPhase - 1` samples before the pending chunk, then the chunk
+    private var history: [Float]
+    /// Position of the next output in upsampled samples from `history[0]`
+    private var position: Int
+    private var inputCount = 0
+    private var outputCount = 0
+
+    public init(inputRate: Int, outputRate: Int) throws {
+        guard inputRate > 0, outputRate > 0 else {
+            throw TTSError.invalidInput("Sample rates must be positive, got \(inputRate) -> \(outputRate)")
+        }
+        let divisor = PolyphaseResampler.gcd(inputRate, outputRate)
+        let interpolation = outputRate / divisor
+        let decimation = inputRate / divisor
+        guard interpolation <= PolyphaseResampler.maxInterpolation else {
+            throw TTSError.invalidInput("Unsupported resampling ratio \(inputRate) -> \(outputRate)")
+        }
+
+        self.inputRate = inputRate
+        self.outputRate = outputRate
+        self.interpolation = interpolation
+        self.decimation = decimation
+        let bank = FilterBank.shared(interpolation: interpolation, decimation: decimation)
+        self.bank = bank
+        self.tapsPerPhase = bank.tapsPerPhase
+
+        self.history = [Float](repeating: 0, count: bank.tapsPerPhase - 1)
+        self.position = (bank.tapsPerPhase - 1) * interpolation + bank.delay
+    }
+
+    /// Resamples a chunk, appending the produced samples to `output`
+    public mutating func process(_ input: UnsafeBufferPointer<Float>, into output: inout [Float]) {
+        inputCount += input.count
+        history.append(contentsOf: input)
+        run(into: &output, limit: Int.max)
+    }
+
+    /// Drains the filter delay; the resampler can be reused for a new stream afterwards
+    public mutating func flush(into output: inout [Float]) {
+        let expected = (inputCount * interpolation + decimation - 1) / decimation
+        let tail = delay / interpolation + 1
+        history.append(contentsOf: repeatElement(0, count: tail))
+        run(into: &output, limit: expected - outputCount)
+        reset()
+    }
+
+    /// Forgets the stream state
+    public mutating func reset() {
+        history = [Float](repeating: 0, count: tapsPerPhase - 1)
+        position = (tapsPerPhase - 1) * interpolation + delay
+        inputCount = 0
+        outputCount = 0
+    }
+
+    private mutating func run(into output: inout [Float], limit: Int) {
+        let taps = tapsPerPhase
+        let interpolation = interpolation
+        let decimation = decimation
+        let available = history.count
+        var position = self.position
+        var produced = 0
+        output.reserveCapacity(output.count + (available * interpolation) / decimation + 1)
+
+        history.withUnsafeBufferPointer { history in
+            bank.coefficients.withUnsafeBufferPointer { banks in
+                // Newest sample of output n is history[position / L]
+                while position / interpolation < available && produced < limit {
+                    let newest = position / interpolation
+                    let phase = position % interpolation
+                    var sample: Float = 0
+                    vDSP_dotpr(history.baseAddress! + newest - taps + 1, 1,
+                               banks.baseAddress! + phase * taps, 1,
+                               &sample, vDSP_Length(taps))
+                    output.append(sample)
+                    produced += 1
+                    position += decimation
+                }
+            }
+        }
+        outputCount += produced
+
+        // Keep the last taps - 1 samples, rebase the position
+        let consumed = max(available - (taps - 1), 0)
+        if consumed > 0 {
+            history.removeFirst(consumed)
+            position -= consumed * interpolation
+        }
+        self.position = position
+    }
+
+    private static func gcd(_ a: Int, _ b: Int) -> Int {
+        var (a, b) = (a, b)
+        while b != 0 {
+            (a, b) = (b, a % b)
+        }
+        return a
+    }
+}
+
+/// Phase filters for one reduced ratio `L / M`, designed on first use and then cached
+final class FilterBank: Sendable {
+    let tapsPerPhase: Int
+    /// Filter delay in upsampled samples
+    let delay: Int
+    /// `L` reversed phase filters of `tapsPerPhase` taps, back to back
+    let coefficients: [Float]
+
+    /// Zero crossings of the sinc on each side, trades transition width for cost
+    private static let zeroCrossings = 16.0
+    /// Cutoff as a fraction of the lower Nyquist frequency
+    private static let rolloff = 0.92
+    /// Kaiser beta, about 80 dB stopband
+    private static let kaiserBeta = 8.0
+
+    private struct Ratio: Hashable {
+        let interpolation: Int
+        let decimation: Int
+    }
+
+    private final class Cache: @unchecked Sendable {
+        let lock = NSLock()
+        var banks: [Ratio: FilterBank] = [:]
+    }
+
+    private static let cache = Cache()
+
+    /// The bank for `interpolation / decimation`, designed once per process
+    static func shared(interpolation: Int, decimation: Int) -> FilterBank {
+        let ratio = Ratio(interpolation: interpolation, decimation: decimation)
+        cache.lock.lock()
+        defer { cache.lock.unlock() }
+        if let bank = cache.banks[ratio] {
+            return bank
+        }
+        let bank = FilterBank(interpolation: interpolation, decimation: decimation)
+        cache.banks[ratio] = bank
+        return bank
+    }
+
+    private init(interpolation: Int, decimation: Int) {
+        // Cutoff in cycles per upsampled sample, below both Nyquist frequencies
+        let cutoff = 0.5 / Double(max(interpolation, decimation)) * FilterBank.rolloff
+        let taps = Int((FilterBank.zeroCrossings / cutoff / Double(interpolation)).rounded(.up))
+        let length = taps * interpolation
+        // Integer center keeps the output on the input time grid; with an even
+        // length the last tap falls outside the window and stays zero
+        let delay = (length - 1) / 2
+
+        var prototype = [Double](repeating: 0, count: length)
+        let windowNorm = FilterBank.besselI0(FilterBank.kaiserBeta)
+        for k in 0..<length {
+            let t = Double(k - delay)
+            let ratio = delay > 0 ? t / Double(delay) : 0
+            guard abs(ratio) <= 1 else { continue }
+            let x = 2 * cutoff * t
+            let sinc = x == 0 ? 1 : sin(Double.pi * x) / (Double.pi * x)
+            let window = FilterBank.besselI0(FilterBank.kaiserBeta * (1 - ratio * ratio).squareRoot()) / windowNorm
+            // Gain L compensates the zeros inserted by upsampling
+            prototype[k] = 2 * cutoff * sinc * window * Double(interpolation)
+        }
+
+        // Phase p uses taps p, p + L, p + 2L, ...; reversed to match oldest-to-newest history
+        var coefficients = [Float](repeating: 0, count: length)
+        for phase in 0..<interpolation {
+            for j in 0..<taps {
+                coefficients[phase * taps + (taps - 1 - j)] = Float(prototype[phase + j * interpolation])
+            }
+        }
+        self.tapsPerPhase = taps
+        self.delay = delay
+        self.coefficients = coefficients
+    }
+
+    /// Modified Bessel function of the first kind, order 0 (power series)
+    private static func besselI0(_ x: Double) -> Double {
+        var sum = 1.0
+        var term = 1.0
+        let half = x / 2
+        for k in 1..<64 {
+            term *= (half / Double(k)) * (half / Double(k))
+            sum += term
+            if term < sum * 1e-12 {
+                break
+            }
+        }
+        return sum
+    }
+}
+
+/// Resamples the vocoder output before passing it on to another sink.
+///
+/// Call `finish()` after the last chunk to flush the filter tail.
+public final class ResamplingAudioSink: AudioSink {
+    public let destination: AudioSink
+    private var resampler: PolyphaseResampler
+    private var scratch: [Float] = []
+
+    public init(destination: AudioSink, inputRate: Int = TTSPipeline.sampleRate, outputRate: Int) throws {
+        self.destination = destination
+        self.resampler = try PolyphaseResampler(inputRate: inputRate, outputRate: outputRate)
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        scratch.removeAll(keepingCapacity: true)
+        resampler.process(samples, into: &scratch)
+        try scratch.withUnsafeBufferPointer { try destination.write($0) }
+    }
+
+    /// Writes the remaining delayed samples
+    public func finish() throws {
+        scratch.removeAll(keepingCapacity: true)
+        resampler.flush(into: &scratch)
+        try scratch.withUnsafeBufferPointer { try destination.write($0) }
+    }
+}
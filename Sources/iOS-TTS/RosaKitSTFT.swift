@@ -70,6 +70,7 @@ class RosaKitSTFT {
         }
         
         // Use RosaKit STFT
+        try Task.checkCancellation()
         let complexSpectogram = audio1D.stft(nFFT: filterLength, hopLength: hopLength)
         
         // Convert complex spectrogram to magnitude and phase
@@ -85,6 +86,8 @@ class RosaKitSTFT {
         // Optimized conversion using direct pointer access
         var idx = 0
         for freqIdx in 0..<freqBins {
+            // One check per frequency row keeps the loop tight
+            try Task.checkCancellation()
             for frameIdx in 0..<numFrames {
                 let complex = complexSpectogram[freqIdx][frameIdx]
                 let real = complex.real
@@ -118,6 +121,7 @@ class RosaKitSTFT {
         // Pre-allocate arrays for better performance
         var idx = 0
         for freqIdx in 0..<freqBins {
+            try Task.checkCancellation()
             var frameArray = [(real: Double, imagine: Double)]()
             frameArray.reserveCapacity(numFrames)
             
@@ -140,6 +144,7 @@ class RosaKitSTFT {
         }
         
         // Use RosaKit ISTFT
+        try Task.checkCancellation()
         let audioDouble = complexSpectrogram.istft(hopLength: hopLength)
         
         // Convert to Float and create MLMultiArray
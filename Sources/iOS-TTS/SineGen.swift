@@ -24,6 +24,9 @@ class SineGen {
     private var invUpsampleScale: Float
     private let halfUpsampleScale: Float = 0.5
     
+    /// Time steps between cancellation checks in the per-sample loops
+    private let cancellationStride = 4096
+    
     init() {
         // Precompute constants
         self.sineAmpDiv3 = sineAmp / 3.0
@@ -54,7 +57,7 @@ class SineGen {
     }
     
     /// Convert F0 to sine waves with optimizations
-    private func f02sine(_ f0Values: MLMultiArray) throws -> MLMultiArray {
+    private func f02sine(_ f0Values: MLMultiArray, random: inout NoiseRandom) throws -> MLMultiArray {
         let batchSize = f0Values.shape[0].intValue
         let length = f0Values.shape[1].intValue
         let harmonics = f0Values.shape[2].intValue
@@ -69,6 +72,9 @@ class SineGen {
         
         // Apply modulo 1
         for i in 0..<radValues.count {
+            if i % (cancellationStride * harmonics) == 0 {
+                try Task.checkCancellation()
+            }
             radPointer[i] = fmodf(radPointer[i], 1.0)
         }
         
@@ -77,7 +83,7 @@ class SineGen {
             for b in 0..<batchSize {
                 for h in 1..<harmonics { // Skip h=0 (fundamental)
                     let index = b * length * harmonics + h
-                    radPointer[index] += Float.random(in: 0..<1)
+                    radPointer[index] += Float.random(in: 0..<1, using: &random)
                 }
             }
         } else {
@@ -237,7 +243,9 @@ class SineGen {
     }
     
     /// Main forward function with optimizations
-    func forward(_ f0: MLMultiArray) throws -> MLMultiArray {
+    /// - Parameter seed: Fixes the phase and noise randomness for reproducible output
+    func forward(_ f0: MLMultiArray, seed: UInt64? = nil) throws -> MLMultiArray {
+        var random = NoiseRandom(seed: seed)
         let batchSize = f0.shape[0].intValue
         let length = f0.shape[1].intValue
         
@@ -249,6 +257,9 @@ class SineGen {
         // Optimized harmonic generation
         for b in 0..<batchSize {
             for t in 0..<length {
+                if t % cancellationStride == 0 {
+                    try Task.checkCancellation()
+                }
                 let f0Value = f0Pointer[b * length + t]
                 let baseIdx = b * length * dim + t * dim
                 
@@ -260,7 +271,7 @@ class SineGen {
         }
         
         // Step 2: Generate sine waveforms
-        let sineWaves = try f02sine(fn)
+        let sineWaves = try f02sine(fn, random: &random)
         
         // Step 3: Apply amplitude using vectorized operations
         let sinePointer = sineWaves.dataPointer.bindMemory(to: Float32.self, capacity: sineWaves.count)
@@ -274,6 +285,9 @@ class SineGen {
         // Step 5: Apply UV and noise in single pass
         for b in 0..<batchSize {
             for t in 0..<length {
+                if t % cancellationStride == 0 {
+                    try Task.checkCancellation()
+                }
                 let uvValue = uvPointer[b * length + t]
                 let noiseAmp = uvValue * noiseStd + (1.0 - uvValue) * sineAmpDiv3
                 let baseIdx = b * length * dim + t * dim
@@ -283,7 +297,7 @@ class SineGen {
                     let sineValue = sinePointer[idx]
                     let noise: Float
                     if useRandomPhase {
-                        noise = Float.random(in: -1...1) * noiseAmp
+                        noise = Float.random(in: -1...1, using: &random) * noiseAmp
                     } else {
                         noise = 0.1 * noiseAmp
                     }
@@ -298,3 +312,20 @@ class SineGen {
         return sineWaves
     }
 }
+
+/// System randomness, or a seeded `SplitMix64` when the output must be reproducible
+struct NoiseRandom: RandomNumberGenerator {
+    private var seeded: SplitMix64?
+    private var system = SystemRandomNumberGenerator()
+
+    init(seed: UInt64?) {
+        self.seeded = seed.map { SplitMix64(seed: $0) }
+    }
+
+    mutating func next() -> UInt64 {
+        if seeded != nil {
+            return seeded!.next()
+        }
+        return system.next()
+    }
+}
@@ -0,0 +1,253 @@
+import Foundation
+import CryptoKit
+import Accelerate
+
+/// Content-addressed cache of synthesized segments with a memory and a disk tier.
+///
+/// The key is a SHA-256 of everything the model output depends on: the
+/// tokenized phoneme ids, voice, speed, pitch options, noise seed and the
+/// model version. `TTSPipeline` caches only seeded requests, the only ones
+/// whose output is reproducible. Values are the model-rate samples of one segment, before
+/// any resampling. The memory tier is an LRU bounded in bytes; evicted and new
+/// entries also live on disk as headerless 16-bit PCM files (half the size of
+/// float32), evicted oldest-access-first once the directory exceeds its limit.
+public final class SynthesisCache: @unchecked Sendable {
+
+    /// SHA-256 digest identifying one synthesized segment
+    public struct Key: Hashable, Sendable {
+        let digest: Data
+
+        /// Hex string used as the disk file name
+        var fileName: String {
+            return digest.map { String(format: "%02x", $0) }.joined() + ".pcm"
+        }
+    }
+
+    /// Hit, miss and eviction counters plus current tier sizes
+    public struct Statistics: Sendable {
+        public let memoryHits: Int
+        public let diskHits: Int
+        public let misses: Int
+        public let memoryEvictions: Int
+        public let diskEvictions: Int
+        public let memoryBytes: Int
+        public let diskBytes: Int
+
+        public var hitRate: Double {
+            let total = memoryHits + diskHits + misses
+            return total == 0 ? 0 : Double(memoryHits + diskHits) / Double(total)
+        }
+    }
+
+    public let memoryLimit: Int
+    public let diskLimit: Int
+    public let directory: URL?
+
+    private struct MemoryEntry {
+        let samples: [Float]
+        var lastAccess: UInt64
+    }
+
+    private let lock = NSLock()
+    /// Serializes changes to the disk tier so `diskBytes` matches the directory;
+    /// taken before `lock`, lookups in memory never wait on a file write
+    private let diskLock = NSLock()
+    private var memory: [Key: MemoryEntry] = [:]
+    private var memoryBytes = 0
+    private var diskBytes = 0
+    private var clock: UInt64 = 0
+
+    private var memoryHits = 0
+    private var diskHits = 0
+    private var misses = 0
+    private var memoryEvictions = 0
+    private var diskEvictions = 0
+
+    /// - Parameters:
+    ///   - memoryLimit: Bytes of float32 samples kept in memory
+    ///   - directory: Disk tier location, `nil` for memory only
+    ///   - diskLimit: Bytes of PCM files kept in `directory`
+    public init(memoryLimit: Int = 32 * 1024 * 1024, directory: URL? = nil, diskLimit: Int = 256 * 1024 * 1024) throws {
+        self.memoryLimit = max(memoryLimit, 0)
+        self.diskLimit = max(diskLimit, 0)
+        self.directory = directory
+        if let directory = directory {
+            try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+            diskBytes = diskFiles().reduce(0) { $0 + $1.size }
+        }
+    }
+
+    /// Key of a segment; `ids` are the tokenizer output, so equivalent phoneme strings share entries
+    public static func key(ids: [Int], options: GenerationOptions, modelVersion: String) -> Key {
+        var hasher = SHA256()
+        func update<T>(_ value: T) {
+            withUnsafeBytes(of: value) { hasher.update(bufferPointer: $0) }
+        }
+        hasher.update(data: Data(modelVersion.utf8))
+        hasher.update(data: Data(options.style.rawValue.utf8))
+        update(options.speed)
+        update(options.pitchShiftSemitones)
+        update(options.pitchRangeScale)
+        update(options.seed ?? 0)
+        update(options.seed != nil)
+        update(ids.count)
+        ids.withUnsafeBytes { hasher.update(bufferPointer: $0) }
+        return Key(digest: Data(hasher.finalize()))
+    }
+
+    /// Cached samples from memory, then disk (promoted back to memory)
+    public func samples(for key: Key) -> [Float]? {
+        lock.lock()
+        if var entry = memory[key] {
+            clock += 1
+            entry.lastAccess = clock
+            memory[key] = entry
+            memoryHits += 1
+            lock.unlock()
+            return entry.samples
+        }
+        lock.unlock()
+
+        guard let samples = readDisk(key) else {
+            lock.lock()
+            misses += 1
+            lock.unlock()
+            return nil
+        }
+        lock.lock()
+        diskHits += 1
+        insertMemory(samples, for: key)
+        lock.unlock()
+        return samples
+    }
+
+    /// Stores a segment in both tiers
+    public func insert(_ samples: [Float], for key: Key) {
+        lock.lock()
+        insertMemory(samples, for: key)
+        lock.unlock()
+        writeDisk(samples, for: key)
+    }
+
+    public func statistics() -> Statistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return Statistics(
+            memoryHits: memoryHits,
+            diskHits: diskHits,
+            misses: misses,
+            memoryEvictions: memoryEvictions,
+            diskEvictions: diskEvictions,
+            memoryBytes: memoryBytes,
+            diskBytes: diskBytes
+        )
+    }
+
+    /// Drops both tiers and resets the counters
+    public func removeAll() {
+        diskLock.lock()
+        defer { diskLock.unlock() }
+        lock.lock()
+        defer { lock.unlock() }
+        memory.removeAll()
+        memoryBytes = 0
+        for file in diskFiles() {
+            try? FileManager.default.removeItem(at: file.url)
+        }
+        diskBytes = 0
+        memoryHits = 0
+        diskHits = 0
+        misses = 0
+        memoryEvictions = 0
+        diskEvictions = 0
+    }
+
+    // MARK: - Memory Tier
+
+    /// Call with `lock` held
+    private func insertMemory(_ samples: [Float], for key: Key) {
+        let bytes = samples.count * MemoryLayout<Float>.size
+        guard bytes <= memoryLimit else { return }
+        clock += 1
+        if let existing = memory.updateValue(MemoryEntry(samples: samples, lastAccess: clock), forKey: key) {
+            memoryBytes -= existing.samples.count * MemoryLayout<Float>.size
+        }
+        memoryBytes += bytes
+        while memoryBytes > memoryLimit, let oldest = memory.min(by: { $0.value.lastAccess < $1.value.lastAccess }) {
+            memory.removeValue(forKey: oldest.key)
+            memoryBytes -= oldest.value.samples.count * MemoryLayout<Float>.size
+            memoryEvictions += 1
+        }
+    }
+
+    // MARK: - Disk Tier
+
+    private func readDisk(_ key: Key) -> [Float]? {
+        guard let directory = directory else { return nil }
+        let url = directory.appendingPathComponent(key.fileName)
+        guard let data = try? Data(contentsOf: url), !data.isEmpty else { return nil }
+        // Access time for eviction order
+        try? FileManager.default.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+
+        let count = data.count / MemoryLayout<Int16>.size
+        var samples = [Float](repeating: 0, count: count)
+        data.withUnsafeBytes { raw in
+            samples.withUnsafeMutableBufferPointer { samples in
+                vDSP_vflt16(raw.bindMemory(to: Int16.self).baseAddress!, 1, samples.baseAddress!, 1, vDSP_Length(count))
+                var scale: Float = 1 / 32767
+                vDSP_vsmul(samples.baseAddress!, 1, &scale, samples.baseAddress!, 1, vDSP_Length(count))
+            }
+        }
+        return samples
+    }
+
+    private func writeDisk(_ samples: [Float], for key: Key) {
+        guard let directory = directory, !samples.isEmpty else { return }
+        let bytes = samples.count * MemoryLayout<Int16>.size
+        guard bytes <= diskLimit else { return }
+
+        var pcm = [Int16](repeating: 0, count: samples.count)
+        samples.withUnsafeBufferPointer { samples in
+            pcm.withUnsafeMutableBufferPointer { pcm in
+                let count = vDSP_Length(samples.count)
+                let scaled = UnsafeMutablePointer<Float>.allocate(capacity: samples.count)
+                defer { scaled.deallocate() }
+                var scale: Float = 32767
+                var low: Float = -32768
+                var high: Float = 32767
+                vDSP_vsmul(samples.baseAddress!, 1, &scale, scaled, 1, count)
+                vDSP_vclip(scaled, 1, &low, &high, scaled, 1, count)
+                vDSP_vfixr16(scaled, 1, pcm.baseAddress!, 1, count)
+            }
+        }
+
+        diskLock.lock()
+        defer { diskLock.unlock() }
+        let url = directory.appendingPathComponent(key.fileName)
+        let existing = (try? url.resourceValues(forKeys: [.fileSizeKey]))?.fileSize ?? 0
+        guard (try? pcm.withUnsafeBytes({ try Data($0).write(to: url, options: .atomic) })) != nil else { return }
+
+        lock.lock()
+        defer { lock.unlock() }
+        diskBytes += bytes - existing
+        guard diskBytes > diskLimit else { return }
+        // Oldest access first
+        for file in diskFiles().sorted(by: { $0.modified < $1.modified }) where diskBytes > diskLimit && file.url != url {
+            if (try? FileManager.default.removeItem(at: file.url)) != nil {
+                diskBytes -= file.size
+                diskEvictions += 1
+            }
+        }
+    }
+
+    private func diskFiles() -> [(url: URL, size: Int, modified: Date)] {
+        guard let directory = directory,
+              let urls = try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.fileSizeKey, .contentModificationDateKey]) else {
+            return []
+        }
+        return urls.filter { $0.pathExtension == "pcm" }.compactMap { url in
+            guard let values = try? url.resourceValues(forKeys: [.fileSizeKey, .contentModificationDateKey]) else { return nil }
+            return (url, values.fileSize ?? 0, values.contentModificationDate ?? .distantPast)
+        }
+    }
+}
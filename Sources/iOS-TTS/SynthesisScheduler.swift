@@ -0,0 +1,237 @@
+import Foundation
+
+/// Admission control for concurrent synthesis requests over one `TTSPipeline`.
+///
+/// Requests are phonemized as soon as they arrive, outside the actor, then
+/// wait for one of `maxConcurrentInferences` inference slots. A free slot goes
+/// to the highest priority class first and, within a class, to the request
+/// with the lowest predicted latency from the pipeline's `SynthesisCostModel`
+/// (shortest job first), ties in arrival order.
+/// Model inference runs off the actor; slot and waiter bookkeeping lives in
+/// `InferenceSlots`.
+public actor SynthesisScheduler {
+
+    public enum Priority: Int, CaseIterable, Comparable, Sendable {
+        /// Background rendering, yields slots to interactive requests
+        case batch = 0
+        /// A user is waiting for the audio
+        case interactive = 1
+
+        public static func < (lhs: Priority, rhs: Priority) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    /// Time spent waiting for an inference slot
+    public struct WaitStatistics: Sendable {
+        public let requests: Int
+        public let totalWait: TimeInterval
+        public let maxWait: TimeInterval
+
+        public var averageWait: TimeInterval {
+            return requests == 0 ? 0 : totalWait / Double(requests)
+        }
+    }
+
+    public struct Metrics: Sendable {
+        /// Requests waiting for a slot right now
+        public let queueDepth: Int
+        public let peakQueueDepth: Int
+        public let inFlight: Int
+        public let completed: Int
+        public let cancelled: Int
+        /// Waits of admitted requests per priority class
+        public let waits: [Priority: WaitStatistics]
+    }
+
+    public nonisolated let pipeline: TTSPipeline
+    public nonisolated let maxConcurrentInferences: Int
+
+    private let slots: InferenceSlots
+
+    /// - Parameter maxConcurrentInferences: Inference slots; 1 keeps the Neural Engine to one request at a time
+    public init(pipeline: TTSPipeline, maxConcurrentInferences: Int = 1) {
+        self.pipeline = pipeline
+        self.maxConcurrentInferences = max(maxConcurrentInferences, 1)
+        self.slots = InferenceSlots(capacity: self.maxConcurrentInferences)
+    }
+
+    public nonisolated func generate(
+        text: String,
+        options: GenerationOptions = GenerationOptions(),
+        priority: Priority = .interactive
+    ) async throws -> [Float] {
+        let sink = ArrayAudioSink()
+        try await generate(text: text, options: options, priority: priority, into: sink)
+        return sink.samples
+    }
+
+    /// Phonemizes `text`, waits for an inference slot and synthesizes into `sink`
+    /// - Returns: Number of samples written
+    /// - Throws: `CancellationError` if the task is cancelled while queued
+    @discardableResult
+    public nonisolated func generate(
+        text: String,
+        options: GenerationOptions = GenerationOptions(),
+        priority: Priority = .interactive,
+        into sink: AudioSink
+    ) async throws -> Int {
+        let utterance = try pipeline.prepare(text: text, options: options)
+        let cost = pipeline.estimateCost(utterance)
+        // Microseconds keep the ordering integral
+        try await slots.acquire(priority: priority, cost: Int(cost.seconds * 1_000_000))
+        let result = Result { try pipeline.synthesize(utterance, into: sink) }
+        await slots.release()
+        return try result.get()
+    }
+
+    public nonisolated func metrics() async -> Metrics {
+        return await slots.metrics()
+    }
+}
+
+/// Inference slots and the requests waiting for them, independent of the pipeline.
+///
+/// `acquire` returns at once while a slot is free and nobody is queued,
+/// otherwise it suspends until `release` hands the caller a slot in
+/// `SchedulingQueue` order, or throws `CancellationError` when the waiting
+/// task is cancelled.
+actor InferenceSlots {
+
+    private struct Waiter {
+        let id: UInt64
+        let priority: SynthesisScheduler.Priority
+        let enqueued: DispatchTime
+        let continuation: CheckedContinuation<Void, Error>
+    }
+
+    let capacity: Int
+
+    private var queue = SchedulingQueue<Waiter>()
+    private var nextID: UInt64 = 0
+    private var inFlight = 0
+    private var peakQueueDepth = 0
+    private var completed = 0
+    private var cancelled = 0
+    private var waits: [SynthesisScheduler.Priority: SynthesisScheduler.WaitStatistics] = [:]
+
+    init(capacity: Int) {
+        self.capacity = max(capacity, 1)
+    }
+
+    func metrics() -> SynthesisScheduler.Metrics {
+        return SynthesisScheduler.Metrics(
+            queueDepth: queue.count,
+            peakQueueDepth: peakQueueDepth,
+            inFlight: inFlight,
+            completed: completed,
+            cancelled: cancelled,
+            waits: waits
+        )
+    }
+
+    /// Waits for a slot; every successful call must be paired with `release`
+    func acquire(priority: SynthesisScheduler.Priority, cost: Int) async throws {
+        if inFlight < capacity && queue.isEmpty {
+            inFlight += 1
+            recordWait(0, priority: priority)
+            return
+        }
+
+        nextID += 1
+        let id = nextID
+        try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+                // Cancelled before the handler could find the waiter in the queue
+                guard !Task.isCancelled else {
+                    cancelled += 1
+                    continuation.resume(throwing: CancellationError())
+                    return
+                }
+                queue.insert(Waiter(id: id, priority: priority, enqueued: .now(), continuation: continuation), priority: priority, cost: cost)
+                peakQueueDepth = max(peakQueueDepth, queue.count)
+            }
+        } onCancel: {
+            Task { await self.cancel(id) }
+        }
+    }
+
+    func release() {
+        inFlight -= 1
+        completed += 1
+        while inFlight < capacity, let waiter = queue.popFirst() {
+            inFlight += 1
+            let wait = Double(DispatchTime.now().uptimeNanoseconds - waiter.enqueued.uptimeNanoseconds) / 1e9
+            recordWait(wait, priority: waiter.priority)
+            waiter.continuation.resume()
+        }
+    }
+
+    /// No-op if the waiter already got its slot
+    private func cancel(_ id: UInt64) {
+        guard let waiter = queue.remove(where: { $0.id == id }) else { return }
+        cancelled += 1
+        waiter.continuation.resume(throwing: CancellationError())
+    }
+
+    private func recordWait(_ wait: TimeInterval, priority: SynthesisScheduler.Priority) {
+        let current = waits[priority] ?? SynthesisScheduler.WaitStatistics(requests: 0, totalWait: 0, maxWait: 0)
+        waits[priority] = SynthesisScheduler.WaitStatistics(
+            requests: current.requests + 1,
+            totalWait: current.totalWait + wait,
+            maxWait: max(current.maxWait, wait)
+        )
+    }
+}
+
+/// Waiting requests ordered by priority class, then cost, then arrival.
+///
+/// A linear scan per pop: queues hold tens of requests, not thousands.
+struct SchedulingQueue<Element> {
+    private struct Entry {
+        let element: Element
+        let priority: SynthesisScheduler.Priority
+        let cost: Int
+        let sequence: UInt64
+    }
+
+    private var entries: [Entry] = []
+    private var sequence: UInt64 = 0
+
+    var count: Int {
+        return entries.count
+    }
+
+    var isEmpty: Bool {
+        return entries.isEmpty
+    }
+
+    mutating func insert(_ element: Element, priority: SynthesisScheduler.Priority, cost: Int) {
+        sequence += 1
+        entries.append(Entry(element: element, priority: priority, cost: cost, sequence: sequence))
+    }
+
+    /// Removes the next request to admit
+    mutating func popFirst() -> Element? {
+        guard var best = entries.indices.first else { return nil }
+        for index in entries.indices.dropFirst() where SchedulingQueue.precedes(entries[index], entries[best]) {
+            best = index
+        }
+        return entries.remove(at: best).element
+    }
+
+    mutating func remove(where predicate: (Element) -> Bool) -> Element? {
+        guard let index = entries.firstIndex(where: { predicate($0.element) }) else { return nil }
+        return entries.remove(at: index).element
+    }
+
+    private static func precedes(_ lhs: Entry, _ rhs: Entry) -> Bool {
+        if lhs.priority != rhs.priority {
+            return lhs.priority > rhs.priority
+        }
+        if lhs.cost != rhs.cost {
+            return lhs.cost < rhs.cost
+        }
+        return lhs.sequence < rhs.sequence
+    }
+}
@@ -0,0 +1,42 @@
+import Foundation
+import CoreML
+import Accelerate
+
+/// Builds float32 model inputs with bulk fills and copies.
+///
+/// `MLMultiArray` subscripts box every element in an `NSNumber` and check
+/// the index on each write; these write straight into the array storage.
+enum TensorBuilder {
+
+    /// `[1, length]` array with `value` in `0..<valid` and `fill` after it, e.g. attention and padding masks
+    static func mask(length: Int, valid: Int, value: Float, fill: Float) throws -> MLMultiArray {
+        let array = try MLMultiArray(shape: [1, NSNumber(value: length)], dataType: .float32)
+        let pointer = array.dataPointer.bindMemory(to: Float.self, capacity: length)
+        let valid = min(max(valid, 0), length)
+        var value = value
+        var fill = fill
+        vDSP_vfill(&value, pointer, 1, vDSP_Length(valid))
+        vDSP_vfill(&fill, pointer + valid, 1, vDSP_Length(length - valid))
+        return array
+    }
+
+    /// Array of `shape` holding a copy of `values`, which must match its element count
+    static func array(copying values: UnsafeBufferPointer<Float>, shape: [Int]) throws -> MLMultiArray {
+        let count = shape.reduce(1, *)
+        guard values.count == count, let source = values.baseAddress else {
+            throw TTSError.invalidInput("Expected \(count) values for shape \(shape), got \(values.count)")
+        }
+        let array = try MLMultiArray(shape: shape.map { NSNumber(value: $0) }, dataType: .float32)
+        memcpy(array.dataPointer, source, count * MemoryLayout<Float>.size)
+        return array
+    }
+
+    /// Array of `shape` with every element set to `value`
+    static func array(repeating value: Float, shape: [Int]) throws -> MLMultiArray {
+        let count = shape.reduce(1, *)
+        let array = try MLMultiArray(shape: shape.map { NSNumber(value: $0) }, dataType: .float32)
+        var value = value
+        vDSP_vfill(&value, array.dataPointer.bindMemory(to: Float.self, capacity: count), 1, vDSP_Length(count))
+        return array
+    }
+}
@@ -0,0 +1,240 @@
+import Foundation
+import Accelerate
+
+/// Streaming WAV file writer usable as an `AudioSink`.
+///
+/// The header is written up front with zero sizes and patched in `finish()`,
+/// so samples go to disk chunk by chunk as the pipeline produces them.
+/// Conversion runs on Accelerate in fixed-size blocks: clipping to [-1, 1],
+/// optional TPDF dither and rounding to int16 for PCM output.
+public final class WAVFileWriter: AudioSink {
+
+    public enum SampleFormat: Sendable {
+        /// 16-bit signed PCM
+        case pcm16
+        /// 32-bit IEEE float
+        case float32
+
+        var bytesPerSample: Int {
+            switch self {
+            case .pcm16:
+                return 2
+            case .float32:
+                return 4
+            }
+        }
+    }
+
+    /// Samples converted per Accelerate pass, bounds the scratch buffers
+    private static let blockSize = 4096
+
+    public let sampleRate: Int
+    public let format: SampleFormat
+    public let dither: Bool
+    /// Samples written so far
+    public private(set) var count = 0
+
+    private let handle: FileHandle
+    private let layout: HeaderLayout
+    private var scratch: [Float]
+    private var noise: [Float]
+    private var pcm: [Int16]
+    private var random: SplitMix64
+    private var finished = false
+
+    /// Creates (or truncates) `url` and writes a placeholder header
+    /// - Parameters:
+    ///   - dither: Adds ±1 LSB triangular noise before rounding to 16 bit (ignored for float32)
+    ///   - seed: Seed of the dither noise, fixed for reproducible files
+    public init(url: URL, sampleRate: Int = TTSPipeline.sampleRate, format: SampleFormat = .pcm16, dither: Bool = false, seed: UInt64 = 0x5DEECE66D) throws {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw TTSError.invalidInput("Cannot create WAV file at \(url.path)")
+        }
+        self.handle = try FileHandle(forWritingTo: url)
+        self.sampleRate = sampleRate
+        self.format = format
+        self.dither = dither && format == .pcm16
+        self.layout = HeaderLayout(format: format)
+        self.scratch = [Float](repeating: 0, count: WAVFileWriter.blockSize)
+        self.noise = self.dither ? [Float](repeating: 0, count: WAVFileWriter.blockSize) : []
+        self.pcm = format == .pcm16 ? [Int16](repeating: 0, count: WAVFileWriter.blockSize) : []
+        self.random = SplitMix64(seed: seed)
+
+        try handle.write(contentsOf: header(sampleCount: 0))
+    }
+
+    deinit {
+        if !finished {
+            try? finish()
+        }
+    }
+
+    public func write(_ samples: UnsafeBufferPointer<Float>) throws {
+        guard !finished else {
+            throw TTSError.invalidInput("WAV file is already finished")
+        }
+        let dataBytes = (count + samples.count) * format.bytesPerSample
+        guard layout.dataOffset + dataBytes <= Int(UInt32.max) else {
+            throw TTSError.invalidInput("WAV file would exceed 4 GB")
+        }
+
+        var offset = 0
+        while offset < samples.count {
+            let length = min(WAVFileWriter.blockSize, samples.count - offset)
+            let block = UnsafeBufferPointer(rebasing: samples[offset..<(offset + length)])
+            switch format {
+            case .pcm16:
+                try writePCM16(block)
+            case .float32:
+                try writeFloat32(block)
+            }
+            offset += length
+        }
+        count += samples.count
+    }
+
+    /// Patches the header sizes and closes the file; further writes throw
+    public func finish() throws {
+        guard !finished else { return }
+        finished = true
+        let header = header(sampleCount: count)
+        try handle.seek(toOffset: 0)
+        try handle.write(contentsOf: header)
+        try handle.synchronize()
+        try handle.close()
+    }
+
+    /// Writes a whole buffer to `url` in one call
+    public static func write(_ samples: [Float], to url: URL, sampleRate: Int = TTSPipeline.sampleRate, format: SampleFormat = .pcm16, dither: Bool = false) throws {
+        let writer = try WAVFileWriter(url: url, sampleRate: sampleRate, format: format, dither: dither)
+        try samples.withUnsafeBufferPointer { try writer.write($0) }
+        try writer.finish()
+    }
+
+    // MARK: - Conversion
+
+    private func writePCM16(_ block: UnsafeBufferPointer<Float>) throws {
+        let n = vDSP_Length(block.count)
+        var scale: Float = 32767
+        var low: Float = -32768
+        var high: Float = 32767
+
+        scratch.withUnsafeMutableBufferPointer { scratch in
+            let scratch = scratch.baseAddress!
+            vDSP_vsmul(block.baseAddress!, 1, &scale, scratch, 1, n)
+            if dither {
+                fillTriangularNoise(count: block.count)
+                noise.withUnsafeBufferPointer { noise in
+                    vDSP_vadd(scratch, 1, noise.baseAddress!, 1, scratch, 1, n)
+                }
+            }
+            vDSP_vclip(scratch, 1, &low, &high, scratch, 1, n)
+            pcm.withUnsafeMutableBufferPointer { pcm in
+                // Rounds to nearest
+                vDSP_vfixr16(scratch, 1, pcm.baseAddress!, 1, n)
+            }
+        }
+        try pcm.withUnsafeBytes { bytes in
+            try handle.write(contentsOf: Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: bytes.baseAddress!), count: block.count * 2, deallocator: .none))
+        }
+    }
+
+    private func writeFloat32(_ block: UnsafeBufferPointer<Float>) throws {
+        var low: Float = -1
+        var high: Float = 1
+        try scratch.withUnsafeMutableBufferPointer { scratch in
+            vDSP_vclip(block.baseAddress!, 1, &low, &high, scratch.baseAddress!, 1, vDSP_Length(block.count))
+            try handle.write(contentsOf: Data(bytesNoCopy: scratch.baseAddress!, count: block.count * 4, deallocator: .none))
+        }
+    }
+
+    /// Sum of two uniform variables in LSB units: triangular in (-1, 1)
+    private func fillTriangularNoise(count: Int) {
+        let unit: Float = 1.0 / Float(1 << 24)
+        for i in 0..<count {
+            let bits = random.next()
+            let a = Float(bits >> 40) * unit
+            let b = Float((bits >> 16) & 0xFF_FFFF) * unit
+            noise[i] = a - b
+        }
+    }
+
+    // MARK: - Header
+
+    /// Chunk offsets of the header for a sample format
+    private struct HeaderLayout {
+        let formatTag: UInt16
+        let fmtSize: UInt32
+        /// Non-PCM data needs a `fact` chunk with the frame count
+        let hasFact: Bool
+        let dataOffset: Int
+
+        init(format: SampleFormat) {
+            switch format {
+            case .pcm16:
+                formatTag = 1
+                fmtSize = 16
+                hasFact = false
+            case .float32:
+                formatTag = 3
+                fmtSize = 18
+                hasFact = true
+            }
+            // RIFF + WAVE, fmt chunk, optional fact chunk, data chunk header
+            dataOffset = 12 + 8 + Int(fmtSize) + (hasFact ? 12 : 0) + 8
+        }
+    }
+
+    private func header(sampleCount: Int) -> Data {
+        let dataBytes = UInt32(sampleCount * format.bytesPerSample)
+        let bytesPerSample = UInt16(format.bytesPerSample)
+        var data = Data(capacity: layout.dataOffset)
+
+        func append<T: FixedWidthInteger>(_ value: T) {
+            withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+        }
+
+        data.append(contentsOf: Array("RIFF".utf8))
+        append(UInt32(layout.dataOffset - 8) + dataBytes)
+        data.append(contentsOf: Array("WAVE".utf8))
+
+        data.append(contentsOf: Array("fmt ".utf8))
+        append(layout.fmtSize)
+        append(layout.formatTag)
+        append(UInt16(1))  // mono
+        append(UInt32(sampleRate))
+        append(UInt32(sampleRate) * UInt32(bytesPerSample))
+        append(bytesPerSample)
+        append(bytesPerSample * 8)
+        if layout.fmtSize == 18 {
+            append(UInt16(0))  // cbSize
+        }
+
+        if layout.hasFact {
+            data.append(contentsOf: Array("fact".utf8))
+            append(UInt32(4))
+            append(UInt32(sampleCount))
+        }
+
+        data.append(contentsOf: Array("data".utf8))
+        append(dataBytes)
+        return data
+    }
+}
+
+/// Small fast PRNG for dither and seeded vocoder noise (SplitMix64)
+struct SplitMix64: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        self.state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
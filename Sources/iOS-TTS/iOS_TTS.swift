@@ -11,7 +11,7 @@ public enum TTSError: Error {
     case vocabLoadFailed(String)
 }
 
-public enum Language: String, CaseIterable {
+public enum Language: String, CaseIterable, Sendable {
     case englishUS = "en_us"
     case englishGB = "en_gb"
     case french = "fr"
@@ -55,7 +55,7 @@ public enum Language: String, CaseIterable {
     }
 }
 
-public enum VoiceStyle: String, CaseIterable {
+public enum VoiceStyle: String, CaseIterable, Sendable {
     // American English (11 female, 9 male)
     case afHeart = "af_heart"
     case afAlloy = "af_alloy"
@@ -208,6 +208,10 @@ public enum Gender: String, CaseIterable {
 /// - `speed`: Playback speed 0.5-2.0 (default: 1.0)
 /// - `pitchShiftSemitones`: Pitch shift -12 to +12 semitones (default: 0)
 /// - `pitchRangeScale`: Expressiveness 0.5-1.5 (default: 1.0)
+/// - `outputSampleRate`: Sample rate of the returned audio in Hz (default: 24000, the model rate).
+///   Other rates (8000, 16000, 22050, 44100, 48000, ...) go through `PolyphaseResampler`.
+/// - `seed`: Seed of the vocoder's phase and noise randomness; `nil` draws fresh noise each call
+/// - `bypassCache`: Skips `TTSPipeline.synthesisCache` for this request; requests without a `seed` always skip it
 ///
 /// ## Usage
 /// ```swift
@@ -222,56 +226,159 @@ public enum Gender: String, CaseIterable {
 ///     pitchRangeScale: 1.2
 /// )
 /// ```
-public struct GenerationOptions {
+public struct GenerationOptions: Sendable {
     public let style: VoiceStyle
     public let speed: Float
     public let pitchShiftSemitones: Float
     public let pitchRangeScale: Float
+    public let outputSampleRate: Int
+    public let seed: UInt64?
+    public let bypassCache: Bool
     
     public init(
         style: VoiceStyle = .amAdam,
         speed: Float = 1.0,
         pitchShiftSemitones: Float = 0.0,
-        pitchRangeScale: Float = 1.0
+        pitchRangeScale: Float = 1.0,
+        outputSampleRate: Int = TTSPipeline.sampleRate,
+        seed: UInt64? = nil,
+        bypassCache: Bool = false
     ) {
         self.style = style
         self.speed = max(0.5, min(2.0, speed))
         self.pitchShiftSemitones = max(-12.0, min(12.0, pitchShiftSemitones))
         self.pitchRangeScale = max(0.5, min(1.5, pitchRangeScale))
+        self.outputSampleRate = outputSampleRate
+        self.seed = seed
+        self.bypassCache = bypassCache
     }
 }
 
 // MARK: - TTS Pipeline
 
-public class TTSPipeline {
+/// A voice's style vectors, read in place from the memory-mapped `.npy` (format: 510x1x256)
+struct StylePack: Sendable {
+    static let rows = 510
+    static let width = 256
+    
+    private let array: NPYMappedArray
+    
+    init(contentsOf url: URL) throws {
+        let array = try NPYParser.mapArray(from: url)
+        // Validate style data format (should be 510x1x256 = 130560 elements)
+        let expectedTotalElements = StylePack.rows * StylePack.width
+        guard array.count == expectedTotalElements else {
+            throw NSError(domain: "TTSPipeline", code: 1, userInfo: [
+                NSLocalizedDescriptionKey: "Style vector should have \(expectedTotalElements) elements (510x1x256), got \(array.count)"
+            ])
+        }
+        self.array = array
+    }
+    
+    /// Row for a sequence of `tokens` phonemes, following Python logic: pack[len(ps)-1]
+    static func row(forTokens tokens: Int) -> Int {
+        return min(max(tokens - 1, 0), rows - 1)
+    }
+    
+    /// Calls `body` with the style vector for `tokens` phonemes, no copy
+    func withStyleVector<R>(forTokens tokens: Int, _ body: (UnsafeBufferPointer<Float>) throws -> R) rethrows -> R {
+        let start = StylePack.row(forTokens: tokens) * StylePack.width
+        return try array.withElements(in: start..<start + StylePack.width, body)
+    }
+}
+
+/// Text front-end output for one request, ready for `TTSPipeline.synthesize(_:into:)`
+public struct PreparedUtterance: Sendable {
+    public let options: GenerationOptions
+    /// Phoneme segments, each within the model context
+    public let segments: [String]
+    let stylePack: StylePack
+    
+    /// Total phonemes over all segments, a proxy for the inference cost
+    public var phonemeCount: Int {
+        return segments.reduce(0) { $0 + $1.unicodeScalars.count }
+    }
+}
+
+/// Text-to-speech pipeline over one loaded `TTSModel`.
+///
+/// `prepare` (G2P, voice loading, segmentation) and `synthesize` (model
+/// inference) can be called from any thread; `SynthesisScheduler` uses the
+/// split to phonemize requests before they compete for inference slots.
+/// Configure `synthesisCache` before sharing the pipeline between threads.
+public final class TTSPipeline: @unchecked Sendable {
+    /// Output sample rate of the vocoder in Hz
+    public static let sampleRate = 24_000
+    
     private let model: TTSModel
     private let modelPath: URL
     private let vocabURL: URL
     private let postaggerModelURL: URL
     public private(set) var language: Language
     private let g2p: G2P
-    private var vocab: [String: Int] = [:]
+    /// `G2P` implementations are not required to be thread-safe
+    private let g2pLock = NSLock()
+    private var tokenizer = PhonemeTokenizer(vocab: [:])
+    /// Identifies the loaded weights in `synthesisCache` keys
+    private let modelVersion: String
+    
+    /// Optional cache of synthesized segments for requests with a `GenerationOptions.seed`.
+    /// Unseeded requests draw fresh noise and are never cached; `bypassCache` skips it per request.
+    public var synthesisCache: SynthesisCache?
+    
+    /// Latency and memory estimator, calibrated by every inference of the model (shared by pipelines over one model)
+    public var costModel: SynthesisCostModel {
+        return model.costModel
+    }
+    
+    /// Peak tensor memory allowed per segment. `prepare` splits text into
+    /// segments predicted to fit, and inference stops after ProsodyPredictor
+    /// when the actual durations would exceed it. `nil` means no limit.
+    public var maxPeakTensorBytes: Int?
+    
+    /// Input lengths requests are padded to, see `LengthBuckets`. Off by default:
+    /// padding changes prosody through the models' recurrent layers.
+    public var lengthBuckets: LengthBuckets = .none
+    
+    private let bucketStatistics = LengthBucketStatistics()
+    
+    private let cancellations = CancellationCounter()
     
     public var performanceMonitoringEnabled: Bool {
         get { PerformanceMonitor.shared.isEnabled }
         set { PerformanceMonitor.shared.isEnabled = newValue }
     }
     
-    public init(modelPath: URL, vocabURL: URL, postaggerModelURL: URL, language: Language, g2p: G2P? = nil, configuration: MLModelConfiguration = MLModelConfiguration()) throws {
+    /// Loads the model bundles concurrently (see `loadReport`).
+    /// - Parameters:
+    ///   - residency: `.onDemand` defers each sub-model to its first use and unloads idle ones
+    ///   - warmUp: Runs `warmUp()` before returning, so the first request is not slowed by Core ML specialization
+    public convenience init(modelPath: URL, vocabURL: URL, postaggerModelURL: URL, language: Language, g2p: G2P? = nil, configuration: MLModelConfiguration = MLModelConfiguration(), residency: ModelResidencyPolicy = .resident, warmUp: Bool = false) throws {
+        let model = try TTSModel(modelPath: modelPath, configuration: configuration, residency: residency)
+        try self.init(model: model, modelPath: modelPath, vocabURL: vocabURL, postaggerModelURL: postaggerModelURL, language: language, g2p: g2p, warmUp: warmUp)
+    }
+    
+    /// Builds a language front end (G2P and vocabulary) over an already loaded model.
+    ///
+    /// The acoustic models are language-agnostic, so several pipelines can
+    /// share one `TTSModel`; see `TTSModelRegistry`.
+    /// - Parameter modelPath: Directory with the voice `.npy` files
+    public init(model: TTSModel, modelPath: URL, vocabURL: URL, postaggerModelURL: URL, language: Language, g2p: G2P? = nil, warmUp: Bool = false) throws {
         self.modelPath = modelPath
         self.vocabURL = vocabURL
         self.postaggerModelURL = postaggerModelURL
         self.language = language
-        self.model = try TTSModel(modelPath: modelPath, configuration: configuration)
+        self.model = model
+        self.modelVersion = TTSPipeline.modelVersion(of: modelPath)
 
         if let externalG2P = g2p {
             self.g2p = externalG2P
         } else {
             switch language {
             case .englishUS:
-                self.g2p = try G2PEn(british: false, vocabURL: vocabURL, postaggerModelURL: postaggerModelURL)
+                self.g2p = try G2PEn(british: false, vocabURL: vocabURL, postaggerModelURL: postaggerModelURL, residency: model.residency)
             case .englishGB:
-                self.g2p = try G2PEn(british: true, vocabURL: vocabURL, postaggerModelURL: postaggerModelURL)
+                self.g2p = try G2PEn(british: true, vocabURL: vocabURL, postaggerModelURL: postaggerModelURL, residency: model.residency)
             case .japanese:
                 self.g2p = G2PJa()
             case .chinese:
@@ -281,74 +388,396 @@ public class TTSPipeline {
             }
         }
         try loadVocabulary()
+        
+        if warmUp {
+            try self.warmUp()
+            // Warm-up tokens are not user input
+            tokenizer.resetStatistics()
+        }
     }
     
-    private func getInputIds(from text: String) throws -> [Int] {
-        let g2pResult = try g2p.convert(text)
-        let phonemeString = g2pResult.phonemeString
+    public func generate(text: String, options: GenerationOptions = GenerationOptions()) async throws -> [Float] {
+        let sink = ArrayAudioSink()
+        try await generate(text: text, options: options, into: sink)
+        return sink.samples
+    }
+    
+    /// Synthesizes `text` and writes the samples straight into `sink`, without an intermediate array
+    /// - Returns: Number of samples written
+    @discardableResult
+    public func generate(text: String, options: GenerationOptions = GenerationOptions(), into sink: AudioSink) async throws -> Int {
+        return try synthesize(prepare(text: text, options: options), into: sink)
+    }
+    
+    /// Runs the text front end: voice check and style pack, G2P, segmentation to the model context
+    public func prepare(text: String, options: GenerationOptions = GenerationOptions()) throws -> PreparedUtterance {
+        let stylePack = try loadStylePack(for: options)
+        let phonemes = try phonemize(text)
+        var maxPhonemes = PhonemeSegmenter.defaultMaxPhonemes
+        if let budget = maxPeakTensorBytes {
+            // Two of the tokens are pads
+            maxPhonemes = min(costModel.maxTokens(peakTensorBytes: budget, speed: options.speed) - 2, maxPhonemes)
+            guard maxPhonemes > 0 else {
+                throw TTSError.invalidInput("maxPeakTensorBytes \(budget) is too small for any segment")
+            }
+        }
+        var segmenter = PhonemeSegmenter(maxPhonemes: maxPhonemes)
+        var segments = segmenter.append(phonemes)
+        if let last = segmenter.finish() {
+            segments.append(last)
+        }
+        return PreparedUtterance(options: options, segments: segments, stylePack: stylePack)
+    }
+    
+    /// Predicted latency and peak tensor memory of a prepared request
+    public func estimateCost(_ utterance: PreparedUtterance) -> SynthesisCost {
+        return costModel.estimate(utterance)
+    }
+    
+    /// Runs the model over prepared segments, writing the audio into `sink`
+    /// - Returns: Number of samples written at `outputSampleRate`
+    @discardableResult
+    public func synthesize(_ utterance: PreparedUtterance, into sink: AudioSink) throws -> Int {
+        let output = try OutputStage(sink: sink, options: utterance.options)
+        for (index, segment) in utterance.segments.enumerated() {
+            try checkCancellation(skipping: utterance.segments[index...], options: utterance.options)
+            try synthesize(phonemes: segment, stylePack: utterance.stylePack, options: utterance.options, into: output.sink)
+        }
+        return try output.finish()
+    }
+    
+    // MARK: - Cancellation
+    
+    /// Work skipped because the calling task was cancelled, in cost model terms
+    public struct CancellationReport: Sendable {
+        /// Segments stopped during inference
+        public let interruptedSegments: Int
+        /// Segments never started
+        public let skippedSegments: Int
+        /// Model stages not completed, summed over all cancelled segments
+        public let skippedStages: Int
+        /// Predicted inference time of the skipped work
+        public let savedSeconds: TimeInterval
+    }
+    
+    public var cancellationReport: CancellationReport {
+        return cancellations.report()
+    }
+    
+    /// Throws `CancellationError` before a segment, counting `segments` as skipped
+    private func checkCancellation<Segments: Collection>(skipping segments: Segments, options: GenerationOptions) throws where Segments.Element == String {
+        guard Task.isCancelled else { return }
+        let seconds = segments.reduce(0) { $0 + costModel.estimate(tokens: $1.unicodeScalars.count + 2, speed: options.speed).seconds }
+        cancellations.record(interrupted: 0, skipped: segments.count, stages: segments.count * SynthesisCostModel.stageCount, seconds: seconds)
+        throw CancellationError()
+    }
+    
+    private final class CancellationCounter: @unchecked Sendable {
+        private let lock = NSLock()
+        private var interrupted = 0
+        private var skipped = 0
+        private var stages = 0
+        private var seconds: TimeInterval = 0
+        
+        func record(interrupted: Int, skipped: Int, stages: Int, seconds: TimeInterval) {
+            lock.lock()
+            defer { lock.unlock() }
+            self.interrupted += interrupted
+            self.skipped += skipped
+            self.stages += stages
+            self.seconds += seconds
+        }
+        
+        func report() -> CancellationReport {
+            lock.lock()
+            defer { lock.unlock() }
+            return CancellationReport(interruptedSegments: interrupted, skippedSegments: skipped, skippedStages: stages, savedSeconds: seconds)
+        }
+    }
+    
+    private func phonemize(_ text: String) throws -> String {
+        g2pLock.lock()
+        defer { g2pLock.unlock() }
+        return try g2p.convert(text).phonemeString
+    }
+    
+    // MARK: - Document Rendering
+    
+    /// Counters of a finished `renderDocument` call
+    public struct DocumentRenderSummary: Sendable {
+        public let lines: Int
+        public let sentences: Int
+        /// Model calls, each at most `PhonemeSegmenter.defaultMaxPhonemes` phonemes
+        public let segments: Int
+        /// Samples written at `outputSampleRate`
+        public let samples: Int
+    }
+    
+    /// Renders a document of any length, streaming audio into `sink` segment by segment.
+    ///
+    /// Lines are grouped into paragraphs and sentences incrementally, phonemized
+    /// one sentence at a time and packed into segments that fit the model
+    /// context. Only the current paragraph, segment and its audio are held in
+    /// memory, so peak memory does not depend on the document length.
+    ///
+    /// - Parameters:
+    ///   - lines: Text lines, e.g. `MappedTextLines` or `URL.lines`
+    ///   - sink: Receives the samples of each segment in order
+    @discardableResult
+    public func renderDocument<Lines: AsyncSequence>(
+        lines: Lines,
+        options: GenerationOptions = GenerationOptions(),
+        into sink: AudioSink
+    ) async throws -> DocumentRenderSummary where Lines.Element: StringProtocol {
+        let stylePack = try loadStylePack(for: options)
+        let output = try OutputStage(sink: sink, options: options)
+        var segmenter = DocumentSegmenter()
+        var phonemeSegmenter = PhonemeSegmenter()
+        var lineCount = 0
+        var sentenceCount = 0
+        var segmentCount = 0
         
-        var inputIds: [Int] = []
+        func render(_ segments: [String]) throws {
+            for (index, segment) in segments.enumerated() {
+                try checkCancellation(skipping: segments[index...], options: options)
+                try synthesize(phonemes: segment, stylePack: stylePack, options: options, into: output.sink)
+                segmentCount += 1
+            }
+        }
         
-        for scalar in phonemeString.unicodeScalars {
-            let charStr = String(Character(scalar))
-            
-            if let vocabId = vocab[charStr] {
-                inputIds.append(vocabId)
+        func phonemizeSentences(_ sentences: [String]) throws {
+            for sentence in sentences {
+                sentenceCount += 1
+                try render(phonemeSegmenter.append(phonemize(sentence)))
+            }
+        }
+        
+        for try await line in lines {
+            try Task.checkCancellation()
+            lineCount += 1
+            try phonemizeSentences(segmenter.append(line: line))
+        }
+        try phonemizeSentences(segmenter.finish())
+        if let last = phonemeSegmenter.finish() {
+            try render([last])
+        }
+        let sampleCount = try output.finish()
+        
+        return DocumentRenderSummary(lines: lineCount, sentences: sentenceCount, segments: segmentCount, samples: sampleCount)
+    }
+    
+    /// Renders a UTF-8 text file through a memory mapping, see `renderDocument(lines:options:into:)`
+    @discardableResult
+    public func renderDocument(
+        contentsOf url: URL,
+        options: GenerationOptions = GenerationOptions(),
+        into sink: AudioSink
+    ) async throws -> DocumentRenderSummary {
+        return try await renderDocument(lines: MappedTextLines(contentsOf: url), options: options, into: sink)
+    }
+    
+    // MARK: - Synthesis
+    
+    /// Sink chain after the vocoder: resampling to `outputSampleRate` when needed, then a sample counter
+    private struct OutputStage {
+        let sink: AudioSink
+        private let resampler: ResamplingAudioSink?
+        private let counter: CountingAudioSink
+        
+        init(sink: AudioSink, options: GenerationOptions) throws {
+            counter = CountingAudioSink(destination: sink)
+            if options.outputSampleRate != TTSPipeline.sampleRate {
+                let resampler = try ResamplingAudioSink(destination: counter, outputRate: options.outputSampleRate)
+                self.resampler = resampler
+                self.sink = resampler
             } else {
-                let unkId = vocab["<unk>"] ?? vocab["[UNK]"] ?? 1
-                inputIds.append(unkId)
+                resampler = nil
+                self.sink = counter
             }
         }
         
-        let bosEosId = vocab["<pad>"] ?? vocab["[PAD]"] ?? 0
-        let finalIds = [bosEosId] + inputIds + [bosEosId]
+        /// Flushes the resampler tail
+        /// - Returns: Samples delivered to the caller's sink
+        func finish() throws -> Int {
+            try resampler?.finish()
+            return counter.count
+        }
+    }
+    
+    private final class CountingAudioSink: AudioSink {
+        let destination: AudioSink
+        private(set) var count = 0
+        
+        init(destination: AudioSink) {
+            self.destination = destination
+        }
         
-        return finalIds
+        func write(_ samples: UnsafeBufferPointer<Float>) throws {
+            try destination.write(samples)
+            count += samples.count
+        }
     }
     
-    public func generate(text: String, options: GenerationOptions = GenerationOptions()) async throws -> [Float] {
+    /// Maps the voice's style vectors; pages are read when a row is used
+    private func loadStylePack(for options: GenerationOptions) throws -> StylePack {
         // Verify voice language matches pipeline language
         let voiceLanguage = options.style.language
         guard voiceLanguage == language else {
             throw TTSError.invalidInput("Voice language \(voiceLanguage.rawValue) doesn't match pipeline language \(language.rawValue)")
         }
         
-        // Load style vectors from .npy file (format: 510x1x256)
         let styleURL = modelPath.appendingPathComponent(options.style.filename)
-        let rawStyleVector = try NPYParser.loadArray(from: styleURL)
+        return try StylePack(contentsOf: styleURL)
+    }
+    
+    /// Serves a seeded segment from `synthesisCache` when enabled, otherwise runs the model
+    @discardableResult
+    private func synthesize(phonemes: String, stylePack: StylePack, options: GenerationOptions, into sink: AudioSink) throws -> Int {
+        // Without a seed the output differs on every call, a cached draw would pin it
+        guard let cache = synthesisCache, !options.bypassCache, options.seed != nil else {
+            return try infer(phonemes: phonemes, stylePack: stylePack, options: options, into: sink)
+        }
         
-        // Get input IDs
-        let inputIds = try getInputIds(from: text)
-        let sequenceLength = inputIds.count
+        let key = SynthesisCache.key(ids: tokenizer.encode(phonemes), options: options, modelVersion: modelVersion + lengthBuckets.cacheTag)
+        let samples: [Float]
+        if let cached = cache.samples(for: key) {
+            samples = cached
+        } else {
+            let buffer = ArrayAudioSink()
+            try infer(phonemes: phonemes, stylePack: stylePack, options: options, into: buffer)
+            samples = buffer.samples
+            cache.insert(samples, for: key)
+        }
+        try samples.withUnsafeBufferPointer { try sink.write($0) }
+        return samples.count
+    }
+    
+    /// Runs the model with a trace: feeds the cost model, or counts the saved work when cancelled
+    @discardableResult
+    private func infer(phonemes: String, stylePack: StylePack, options: GenerationOptions, into sink: AudioSink) throws -> Int {
+        let tokens = tokenizer.tokenCount(for: phonemes)
+        let frameLimit = maxPeakTensorBytes.map { costModel.maxFrames(tokens: tokens, peakTensorBytes: $0) }
+        let trace = InferenceTrace(tokens: tokens, speed: options.speed, frameLimit: frameLimit)
+        let buckets = lengthBuckets
         
-        // Validate style data format (should be 510x1x256 = 130560 elements)
-        let expectedTotalElements = 510 * 256
-        guard rawStyleVector.count == expectedTotalElements else {
-            throw NSError(domain: "TTSPipeline", code: 1, userInfo: [
-                NSLocalizedDescriptionKey: "Style vector should have \(expectedTotalElements) elements (510x1x256), got \(rawStyleVector.count)"
-            ])
+        let count: Int
+        do {
+            count = try run(phonemes: phonemes, stylePack: stylePack, options: options, buckets: buckets, trace: trace, into: sink)
+        } catch let error as CancellationError {
+            // Stages missing from the trace did not complete; durations refine the estimate when known
+            let estimate = costModel.estimate(tokens: tokens, speed: options.speed)
+            let cost = trace.frames.map { costModel.refined(estimate, frames: $0) } ?? estimate
+            let skipped = cost.stageSeconds.filter { trace.stageSeconds[$0.key] == nil }
+            cancellations.record(interrupted: 1, skipped: 0, stages: skipped.count, seconds: skipped.values.reduce(0, +))
+            throw error
+        }
+        costModel.record(trace)
+        bucketStatistics.record(trace, buckets: buckets)
+        return count
+    }
+    
+    /// Writes `[pad] + ids + [pad]` straight into the model's `input_ids` array and runs the model
+    /// - Parameter buckets: Lengths the ids and frames are padded to
+    @discardableResult
+    private func run(phonemes: String, stylePack: StylePack, options: GenerationOptions, buckets: LengthBuckets = .none, trace: InferenceTrace, into sink: AudioSink) throws -> Int {
+        let sequenceLength = tokenizer.tokenCount(for: phonemes)
+        let paddedLength = buckets.tokenBucket(for: sequenceLength)
+        let inputIds = try tokenizer.makeInputIdsArray(for: phonemes, length: paddedLength)
+        if paddedLength != sequenceLength {
+            trace.paddedTokens = paddedLength
         }
         
         // Select appropriate style vector based on phoneme sequence length
-        // Following Python logic: pack[len(ps)-1] where ps is phoneme sequence
-        let styleIndex = min(max(sequenceLength - 1, 0), 509)
-        let styleStartIndex = styleIndex * 256
-        let styleEndIndex = styleStartIndex + 256
-        
-        let styleVector = Array(rawStyleVector[styleStartIndex..<styleEndIndex])
-        
         #if DEBUG
-        print("Selected style vector \(styleIndex) for sequence length \(sequenceLength)")
+        print("Selected style vector \(StylePack.row(forTokens: sequenceLength)) for sequence length \(sequenceLength)")
         #endif
         
-        // Call model inference with pitch modification parameters
-        return try model.infer(
-            inputIds: inputIds,
-            refS: styleVector,
-            speed: options.speed,
-            pitchShiftSemitones: options.pitchShiftSemitones,
-            pitchRangeScale: options.pitchRangeScale
-        )
+        // Call model inference with pitch modification parameters; the style row is read from the mapping
+        return try stylePack.withStyleVector(forTokens: sequenceLength) { styleVector in
+            try model.infer(
+                inputIds: inputIds,
+                refS: styleVector,
+                speed: options.speed,
+                pitchShiftSemitones: options.pitchShiftSemitones,
+                pitchRangeScale: options.pitchRangeScale,
+                validTokens: sequenceLength,
+                buckets: buckets,
+                seed: options.seed,
+                trace: trace,
+                into: sink
+            )
+        }
+    }
+    
+    // MARK: - Warm-up
+    
+    /// Stage times of the warm-up passes
+    public struct WarmUpReport: Sendable {
+        /// First inference per stage, including Core ML's lazy specialization
+        public let firstInferenceSeconds: [String: TimeInterval]
+        /// Second inference per stage, the steady-state latency
+        public let steadyStateSeconds: [String: TimeInterval]
+        
+        public var firstInferenceTotal: TimeInterval {
+            return firstInferenceSeconds.values.reduce(0, +)
+        }
+        
+        public var steadyStateTotal: TimeInterval {
+            return steadyStateSeconds.values.reduce(0, +)
+        }
+    }
+    
+    /// Short utterance for warm-up; scalars missing from a vocabulary map to `<unk>`, which is fine here
+    private static let warmUpPhonemes = "ðɪs ɪz ə tˈɛst."
+    
+    /// Per-bundle load times of the model
+    public var loadReport: TTSModel.LoadReport {
+        return model.loadReport
+    }
+    
+    /// Which sub-models (and the POS tagger) are loaded, their size and load/unload counts
+    public var residencyReport: [ModelResidencyManager.Entry] {
+        return model.residency.report()
+    }
+    
+    /// Starts loading unloaded sub-models in the background, e.g. when a text field gains focus
+    public func prefetchModels() {
+        model.residency.prefetch()
+    }
+    
+    /// Set by `warmUp()`
+    public private(set) var warmUpReport: WarmUpReport?
+    
+    /// Runs a short utterance through every stage twice, so later requests see steady-state latency.
+    ///
+    /// Uses the first voice of the pipeline language, bypasses `synthesisCache`
+    /// and feeds only the second pass into `costModel`.
+    @discardableResult
+    public func warmUp() throws -> WarmUpReport {
+        guard let style = VoiceStyle.allCases.first(where: { $0.language == language }) else {
+            throw TTSError.invalidInput("No voice for language \(language.rawValue) to warm up with")
+        }
+        let options = GenerationOptions(style: style, seed: 0, bypassCache: true)
+        let stylePack = try loadStylePack(for: options)
+        let tokens = tokenizer.tokenCount(for: TTSPipeline.warmUpPhonemes)
+        
+        var passes: [InferenceTrace] = []
+        for _ in 0..<2 {
+            let trace = InferenceTrace(tokens: tokens)
+            try run(phonemes: TTSPipeline.warmUpPhonemes, stylePack: stylePack, options: options, buckets: lengthBuckets, trace: trace, into: ArrayAudioSink())
+            passes.append(trace)
+        }
+        costModel.record(passes[1])
+        
+        let report = WarmUpReport(firstInferenceSeconds: passes[0].stageSeconds, steadyStateSeconds: passes[1].stageSeconds)
+        warmUpReport = report
+        return report
+    }
+    
+    /// Model directory plus its modification date, so replaced weights miss the cache
+    private static func modelVersion(of modelPath: URL) -> String {
+        let modified = (try? modelPath.resourceValues(forKeys: [.contentModificationDateKey]))?.contentModificationDate
+        return "\(modelPath.standardizedFileURL.path)@\(modified?.timeIntervalSince1970 ?? 0)"
     }
     
     public func getPerformanceReport() -> String {
@@ -363,6 +792,31 @@ public class TTSPipeline {
         PerformanceMonitor.shared.clearMeasurements()
     }
     
+    /// Bytes of model outputs written into reused buffers, in total and for the last request
+    public var outputBackingStatistics: OutputBackingStatistics {
+        return model.outputBackingStatistics
+    }
+    
+    /// See `TTSModel.usesOutputBackings`; shared by every pipeline over the model
+    public var usesOutputBackings: Bool {
+        get { model.usesOutputBackings }
+        set { model.usesOutputBackings = newValue }
+    }
+    
+    /// Lengths presented to the model since the last reset, to tune `lengthBuckets`
+    public var lengthBucketReport: LengthBucketReport {
+        return bucketStatistics.report()
+    }
+    
+    public func resetLengthBucketStatistics() {
+        bucketStatistics.reset()
+    }
+    
+    /// Token and unknown-scalar counts accumulated by the phoneme tokenizer
+    public var tokenizerReport: PhonemeTokenizer.Report {
+        return tokenizer.report
+    }
+    
     private func loadVocabulary() throws {
         let vocabFileName: String
         
@@ -403,10 +857,10 @@ public class TTSPipeline {
             throw TTSError.invalidInput("Invalid vocab file format: \(vocabFileName)")
         }
         
-        self.vocab = vocabDict
+        self.tokenizer = PhonemeTokenizer(vocab: vocabDict)
         
         #if DEBUG
-        print("Loaded \(vocab.count) vocab entries")
+        print("Loaded \(vocabDict.count) vocab entries")
         #endif
     }
 }
@@ -0,0 +1,66 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты приемников аудио
+struct AudioSinkTests {
+
+    private static func write(_ samples: [Float], to sink: AudioSink) throws {
+        try samples.withUnsafeBufferPointer { try sink.write($0) }
+    }
+
+    @Test("Запись в буфер вызывающего")
+    func testContiguousSink() throws {
+        var storage = [Float](repeating: 0, count: 5)
+        try storage.withUnsafeMutableBufferPointer { buffer in
+            let sink = ContiguousAudioSink(buffer: buffer)
+            try Self.write([1, 2], to: sink)
+            try Self.write([3, 4], to: sink)
+            #expect(sink.count == 4)
+            #expect(throws: TTSError.self) { try Self.write([5, 6], to: sink) }
+            #expect(sink.count == 4)
+        }
+        #expect(storage == [1, 2, 3, 4, 0])
+    }
+
+    @Test("Кольцевой буфер: перенос через край и переполнение")
+    func testRingBuffer() throws {
+        let ring = RingBufferAudioSink(capacity: 4)
+        var output = [Float](repeating: 0, count: 4)
+
+        try Self.write([1, 2, 3], to: ring)
+        #expect(output.withUnsafeMutableBufferPointer { ring.read(into: UnsafeMutableBufferPointer(rebasing: $0[0..<2])) } == 2)
+        #expect(output[0..<2] == [1, 2])
+
+        // Запись переходит через конец хранилища
+        try Self.write([4, 5, 6], to: ring)
+        #expect(ring.availableSamples == 4)
+        #expect(output.withUnsafeMutableBufferPointer { ring.read(into: $0) } == 4)
+        #expect(output == [3, 4, 5, 6])
+        #expect(ring.overrunSamples == 0)
+
+        // Читатель отстал: старые сэмплы вытесняются
+        try Self.write([7, 8, 9], to: ring)
+        try Self.write([10, 11, 12, 13, 14], to: ring)
+        #expect(ring.overrunSamples == 4)
+        #expect(output.withUnsafeMutableBufferPointer { ring.read(into: $0) } == 4)
+        #expect(output == [11, 12, 13, 14])
+        #expect(ring.availableSamples == 0)
+    }
+
+    @Test("Файл с float32 сэмплами")
+    func testFileSink() throws {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("sink-\(UUID().uuidString).raw")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let sink = try FileAudioSink(url: url)
+        try Self.write([0.5, -0.25], to: sink)
+        try Self.write([1], to: sink)
+        try sink.close()
+
+        let data = try Data(contentsOf: url)
+        let samples = data.withUnsafeBytes { Array($0.bindMemory(to: Float.self)) }
+        #expect(samples == [0.5, -0.25, 1])
+        #expect(sink.count == 3)
+    }
+}
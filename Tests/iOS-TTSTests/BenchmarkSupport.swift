@@ -0,0 +1,53 @@
+import Testing
+import Foundation
+import Darwin
+
+extension Tag {
+    /// Замеры скорости и памяти: медленные, зависят от машины и пишут в stdout
+    @Tag static var benchmark: Self
+}
+
+/// Вспомогательные функции для бенчмарков в тестах.
+///
+/// Бенчмарки не входят в обычный прогон: `IOS_TTS_BENCHMARKS=1 swift test --filter Бенчмарк`.
+/// Корректность сравниваемых реализаций проверяют обычные тесты.
+enum Benchmark {
+
+    /// Запускать ли тесты с тегом `.benchmark`
+    static let isEnabled = ProcessInfo.processInfo.environment["IOS_TTS_BENCHMARKS"] == "1"
+
+    /// Выполняет `body` `iterations` раз и возвращает число операций в секунду
+    static func throughput(iterations: Int, _ body: () -> Void) -> Double {
+        let start = DispatchTime.now().uptimeNanoseconds
+        for _ in 0..<iterations {
+            body()
+        }
+        let elapsed = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        return Double(iterations) / max(elapsed, 1e-9)
+    }
+
+    /// Время выполнения `body` в секундах
+    static func seconds(_ body: () -> Void) -> Double {
+        let start = DispatchTime.now().uptimeNanoseconds
+        body()
+        return Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+    }
+
+    /// Текущий physical footprint процесса в байтах
+    static func residentMemoryBytes() -> UInt64 {
+        var info = task_vm_info_data_t()
+        var count = mach_msg_type_number_t(MemoryLayout<task_vm_info_data_t>.size / MemoryLayout<natural_t>.size)
+        // task_self_trap вместо глобальной mach_task_self_, которую Swift 6 считает небезопасной
+        let task = task_self_trap()
+        let result = withUnsafeMutablePointer(to: &info) { pointer in
+            pointer.withMemoryRebound(to: integer_t.self, capacity: Int(count)) {
+                task_info(task, task_flavor_t(TASK_VM_INFO), $0, &count)
+            }
+        }
+        return result == KERN_SUCCESS ? info.phys_footprint : 0
+    }
+
+    static func format(bytes: UInt64) -> String {
+        return String(format: "%.2f MB", Double(bytes) / 1_048_576)
+    }
+}
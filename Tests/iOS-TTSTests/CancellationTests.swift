@@ -0,0 +1,53 @@
+import Testing
+import Foundation
+import CoreML
+@testable import iOS_TTS
+
+/// Тесты кооперативной отмены в вокодере
+struct CancellationTests {
+
+    /// F0 формы [1, length, 1] с постоянным тоном
+    private static func f0(length: Int, value: Float = 120) throws -> MLMultiArray {
+        let array = try MLMultiArray(shape: [1, NSNumber(value: length), 1], dataType: .float32)
+        let pointer = array.dataPointer.bindMemory(to: Float32.self, capacity: length)
+        for i in 0..<length {
+            pointer[i] = value
+        }
+        return array
+    }
+
+    @Test("SineGen без отмены отдаёт 9 гармоник")
+    func testSineGenRuns() throws {
+        let output = try SineGen().forward(Self.f0(length: 3_000), seed: 1)
+        #expect(output.shape.map(\.intValue) == [1, 3_000, 9])
+    }
+
+    @Test("SineGen прерывается в отменённой задаче")
+    func testSineGenCancelled() async throws {
+        let f0 = try Self.f0(length: 30_000)
+        let task = Task {
+            withUnsafeCurrentTask { $0?.cancel() }
+            _ = try SineGen().forward(f0)
+        }
+        await #expect(throws: CancellationError.self) { try await task.value }
+    }
+
+    @Test("STFT и обратное STFT прерываются в отменённой задаче")
+    func testSTFTCancelled() async throws {
+        let audio = try MLMultiArray(shape: [1, 24_000], dataType: .float32)
+        let stft = RosaKitSTFT(filterLength: 20, hopLength: 5, winLength: 20)
+        let (magnitude, phase) = try stft.transform(audio)
+
+        let forward = Task {
+            withUnsafeCurrentTask { $0?.cancel() }
+            _ = try stft.transform(audio)
+        }
+        await #expect(throws: CancellationError.self) { try await forward.value }
+
+        let inverse = Task {
+            withUnsafeCurrentTask { $0?.cancel() }
+            _ = try stft.inverse(magnitude, phase)
+        }
+        await #expect(throws: CancellationError.self) { try await inverse.value }
+    }
+}
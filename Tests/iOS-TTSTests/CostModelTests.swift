@@ -0,0 +1,84 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты модели стоимости синтеза
+struct CostModelTests {
+
+    /// Синтетические замеры: этап = 2 мс + 0.1 мс на единицу
+    private static func trace(tokens: Int, frames: Int) -> InferenceTrace {
+        let trace = InferenceTrace(tokens: tokens)
+        trace.frames = frames
+        for module in [PerformanceMonitor.Module.bert, PerformanceMonitor.Module.textEncoder] {
+            trace.stageSeconds[module] = 0.002 + 0.000_1 * Double(tokens)
+        }
+        trace.stageSeconds[PerformanceMonitor.Module.generator] = 0.002 + 0.000_1 * Double(frames)
+        return trace
+    }
+
+    @Test("Оценка растёт с числом токенов и падает с ростом скорости")
+    func testEstimate() {
+        let model = SynthesisCostModel()
+        let short = model.estimate(tokens: 20)
+        let long = model.estimate(tokens: 200)
+        #expect(long.seconds > short.seconds)
+        #expect(long.peakTensorBytes > short.peakTensorBytes)
+        #expect(long.samples == long.frames * 600)
+        #expect(!long.framesMeasured)
+        #expect(model.estimate(tokens: 200, speed: 2).frames < long.frames)
+    }
+
+    @Test("Калибровка сходится к замерам, уточнение подставляет реальные кадры")
+    func testCalibration() {
+        let model = SynthesisCostModel()
+        for tokens in stride(from: 20, through: 400, by: 20) {
+            model.record(Self.trace(tokens: tokens, frames: tokens * 4))
+        }
+        #expect(abs(model.framesPerToken - 4) < 1e-9)
+
+        let estimate = model.estimate(tokens: 100)
+        #expect(estimate.frames == 400)
+        #expect(abs(estimate.stageSeconds[PerformanceMonitor.Module.bert]! - 0.012) < 1e-6)
+        #expect(abs(estimate.stageSeconds[PerformanceMonitor.Module.generator]! - 0.042) < 1e-6)
+
+        let refined = model.refined(estimate, frames: 100)
+        #expect(refined.framesMeasured)
+        #expect(abs(refined.stageSeconds[PerformanceMonitor.Module.generator]! - 0.012) < 1e-6)
+        #expect(refined.peakTensorBytes < estimate.peakTensorBytes)
+    }
+
+    @Test("Пределы по памяти: токены на сегмент и кадры на токены")
+    func testLimits() {
+        let model = SynthesisCostModel()
+        let budget = model.estimate(tokens: 100).peakTensorBytes
+        let tokens = model.maxTokens(peakTensorBytes: budget)
+        #expect(tokens >= 100)
+        #expect(model.estimate(tokens: tokens).peakTensorBytes <= budget)
+        #expect(model.estimate(tokens: tokens + 1).peakTensorBytes > budget)
+        #expect(model.maxTokens(peakTensorBytes: 0) == 0)
+
+        let frames = model.maxFrames(tokens: 100, peakTensorBytes: budget)
+        #expect(SynthesisCostModel.peakTensorBytes(tokens: 100, frames: frames) <= budget)
+        #expect(SynthesisCostModel.peakTensorBytes(tokens: 100, frames: frames + 1) > budget)
+    }
+
+    @Test("Сумма сегментов: время складывается, пик памяти — максимум")
+    func testCombined() {
+        let model = SynthesisCostModel()
+        let a = model.estimate(tokens: 50)
+        let b = model.estimate(tokens: 300)
+        let total = a.combined(with: b)
+        #expect(total.tokens == 350)
+        #expect(abs(total.seconds - (a.seconds + b.seconds)) < 1e-9)
+        #expect(total.peakTensorBytes == b.peakTensorBytes)
+    }
+
+    @Test("Бенчмарк: оценка стоимости запроса", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkEstimate() {
+        let model = SynthesisCostModel()
+        let rate = Benchmark.throughput(iterations: 100_000) {
+            _ = model.estimate(tokens: 256)
+        }
+        print("📊 Оценок в секунду: \(String(format: "%.0f", rate))")
+    }
+}
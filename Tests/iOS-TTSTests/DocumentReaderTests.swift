@@ -0,0 +1,93 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты потокового чтения и сегментации документа
+struct DocumentReaderTests {
+
+    private static func temporaryFile(_ contents: String) throws -> URL {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("document-\(UUID().uuidString).txt")
+        try contents.write(to: url, atomically: true, encoding: .utf8)
+        return url
+    }
+
+    private static func readLines(_ url: URL, maxLineBytes: Int = MappedTextLines.defaultMaxLineBytes) async throws -> [String] {
+        var lines: [String] = []
+        for await line in try MappedTextLines(contentsOf: url, maxLineBytes: maxLineBytes) {
+            lines.append(line)
+        }
+        return lines
+    }
+
+    @Test("Строки из отображенного файла")
+    func testMappedLines() async throws {
+        let url = try Self.temporaryFile("First line.\r\nВторая строка\n\nlast без перевода")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        #expect(try await Self.readLines(url) == ["First line.", "Вторая строка", "", "last без перевода"])
+    }
+
+    @Test("Длинная строка режется по пробелу и границе символа")
+    func testLongLine() async throws {
+        let url = try Self.temporaryFile("aaaa bbbb cccc\nжжжжж")
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let lines = try await Self.readLines(url, maxLineBytes: 7)
+        #expect(lines == ["aaaa ", "bbbb ", "cccc", "жжж", "жж"])
+    }
+
+    @Test("Абзацы и предложения с ограниченным буфером")
+    func testDocumentSegmenter() {
+        var segmenter = DocumentSegmenter(maxParagraphBytes: 40)
+        #expect(segmenter.append(line: "It was late.") == [])
+        #expect(segmenter.append(line: "The rain had stopped") == [])
+        #expect(segmenter.append(line: "hours ago. Nobody came") == ["It was late.", "The rain had stopped hours ago."])
+        #expect(segmenter.append(line: "") == ["Nobody came"])
+        #expect(segmenter.append(line: "Bye!") == [])
+        #expect(segmenter.finish() == ["Bye!"])
+    }
+
+    @Test("Сегменты фонем не превышают контекст модели")
+    func testPhonemeSegmenter() {
+        var segmenter = PhonemeSegmenter(maxPhonemes: 12)
+        #expect(segmenter.append("hˈɛlO") == [])
+        #expect(segmenter.append("wˈɜɹld") == [])
+        // Сначала режем после запятой, затем по пробелу
+        #expect(segmenter.append("ə lˈɔŋ, sˈɛntəns hˈɪɹ") == ["hˈɛlO wˈɜɹld", "ə lˈɔŋ,", "sˈɛntəns"])
+        #expect(segmenter.finish() == "hˈɪɹ")
+        #expect(segmenter.finish() == nil)
+
+        var unbroken = PhonemeSegmenter(maxPhonemes: 4)
+        #expect(unbroken.append("abcdefghij") == ["abcd", "efgh"])
+        #expect(unbroken.finish() == "ij")
+    }
+
+    @Test("Бенчмарк: память при чтении большого документа", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkLargeDocument() async throws {
+        let paragraph = String(repeating: "The quick brown fox jumps over the lazy dog. ", count: 40) + "\n\n"
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("document-\(UUID().uuidString).txt")
+        defer { try? FileManager.default.removeItem(at: url) }
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        let handle = try FileHandle(forWritingTo: url)
+        let chunk = Data(String(repeating: paragraph, count: 256).utf8)
+        for _ in 0..<100 {
+            handle.write(chunk)
+        }
+        try handle.close()
+
+        let before = Benchmark.residentMemoryBytes()
+        var segmenter = DocumentSegmenter()
+        var sentences = 0
+        var peak = before
+        let lines = try MappedTextLines(contentsOf: url)
+        let start = DispatchTime.now().uptimeNanoseconds
+        for await line in lines {
+            sentences += segmenter.append(line: line).count
+            peak = max(peak, Benchmark.residentMemoryBytes())
+        }
+        let seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        sentences += segmenter.finish().count
+
+        print("📊 Документ \(Benchmark.format(bytes: UInt64(lines.byteCount))): \(sentences) предложений за \(String(format: "%.2f", seconds)) с, прирост памяти \(Benchmark.format(bytes: peak - before))")
+    }
+}
@@ -0,0 +1,95 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты сканеров, заменивших регулярные выражения G2P
+struct G2PPatternsTests {
+
+    @Test("Сканеры совпадают с исходными регулярными выражениями")
+    func testScannersMatchRegex() {
+        let words = ["123", "", "12a", "1st", "2nd", "1990s", "10's", "abc", "ABC", "x'",
+                     "vs", "VS.", "cvs", "v.s", "running", "packing", "sing", "ing", "callling",
+                     "buzzing", "fizzing", "hopping", "äbc", "naïve", "café's"]
+
+        for word in words {
+            #expect(G2PPatterns.isASCIIDigits(word) == word.matches("^[0-9]+$"), "digits: \(word)")
+            #expect(G2PPatterns.endsWithVersus(word) == word.matches("(?i)vs\\.?$"), "vs: \(word)")
+            #expect(G2PPatterns.hasDoubledConsonantIng(word) == word.matches("([bcdgklmnprstvxz])\\1ing$|cking$"), "ing: \(word)")
+            #expect(G2PPatterns.lowercaseSuffix(word).map(String.init) == word.firstMatch("[a-z']+$"), "suffix: \(word)")
+        }
+    }
+
+    @Test("Markdown-ссылки разбираются в preprocess")
+    func testPreprocessLinks() {
+        let result = G2PEn.preprocess("Say [Kokoro](/kˈOkəɹO/) twice")
+        #expect(result.result == "Say Kokoro twice")
+        #expect(result.tokens == ["Say", "Kokoro", "twice"])
+        #expect(result.features[1] as? String == "/kˈOkəɹO")
+
+        let plain = G2PEn.preprocess("No links here.")
+        #expect(plain.result == "No links here.")
+        #expect(plain.features.isEmpty)
+    }
+
+    @Test("Бенчмарк: числовой текст, компиляция regex на вызов против сканеров", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkNumberHeavyText() {
+        // Числа, порядковые, годы и суммы - все ветки getNumber/isNumber
+        let words = (0..<2_000).map { i -> String in
+            switch i % 5 {
+            case 0: return "\(i)"
+            case 1: return "\(i % 31 + 1)st"
+            case 2: return "\(1900 + i % 120)s"
+            case 3: return "\(i).\(i % 100)"
+            default: return "\(i)'s"
+            }
+        }
+
+        var legacyCount = 0
+        let legacyRate = Benchmark.throughput(iterations: 10) {
+            for word in words {
+                let regex = try! NSRegularExpression(pattern: "[a-z']+$")
+                if regex.firstMatch(in: word, range: NSRange(word.startIndex..., in: word)) != nil {
+                    legacyCount += 1
+                }
+                if word.range(of: "^[0-9]+$", options: .regularExpression) != nil {
+                    legacyCount += 1
+                }
+            }
+        }
+
+        var scannerCount = 0
+        let scannerRate = Benchmark.throughput(iterations: 10) {
+            for word in words {
+                if G2PPatterns.lowercaseSuffix(word) != nil {
+                    scannerCount += 1
+                }
+                if G2PPatterns.isASCIIDigits(word) {
+                    scannerCount += 1
+                }
+            }
+        }
+
+        // Полный путь лексикона на числах: без единой компиляции regex
+        let lexicon = Lexicon(british: false, golds: [:], silvers: [:])
+        let tokens = words.map { MToken(text: $0, tag: "CD", whitespace: " ") }
+        let lexiconRate = Benchmark.throughput(iterations: 5) {
+            for token in tokens {
+                _ = lexicon.processToken(token, context: TokenContext())
+            }
+        }
+
+        print("📊 regex на вызов: \(Int(legacyRate * Double(words.count))) слов/с, совпадений \(legacyCount)")
+        print("📊 сканеры:        \(Int(scannerRate * Double(words.count))) слов/с, совпадений \(scannerCount)")
+        print("📊 Lexicon.processToken (числа): \(Int(lexiconRate * Double(tokens.count))) токенов/с")
+    }
+}
+
+private extension String {
+    func matches(_ pattern: String) -> Bool {
+        return range(of: pattern, options: .regularExpression) != nil
+    }
+
+    func firstMatch(_ pattern: String) -> String? {
+        return range(of: pattern, options: .regularExpression).map { String(self[$0]) }
+    }
+}
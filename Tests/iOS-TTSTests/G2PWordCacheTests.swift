@@ -0,0 +1,130 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты LRU-кеша результатов лексикона
+struct G2PWordCacheTests {
+
+    private static func key(_ word: String, tag: String = "NN", underscore: MToken.Underscore? = nil, context: TokenContext = TokenContext()) -> G2PWordCache.Key {
+        return G2PWordCache.Key(token: MToken(text: word, tag: tag, underscore: underscore), context: context)
+    }
+
+    /// Значение кеша через `compute`, вызовы которого записываются в `computed`
+    private static func lookup(_ key: G2PWordCache.Key, in cache: G2PWordCache, computed: inout [String]) -> String? {
+        var word: String?
+        let value = cache.value(for: key) {
+            word = key.word
+            return G2PWordCache.Value(phonemes: key.word, rating: 4)
+        }
+        if let word = word {
+            computed.append(word)
+        }
+        return value.phonemes
+    }
+
+    @Test("При заполнении вытесняется давно не использованное слово")
+    func testEvictionOrder() {
+        let cache = G2PWordCache(capacity: 2)
+        var computed: [String] = []
+        for word in ["a", "b", "a", "c", "a", "b", "c"] {
+            #expect(Self.lookup(Self.key(word), in: cache, computed: &computed) == word)
+        }
+        // "a" поднимается обращением, поэтому первым уходит "b", затем "c", затем "a"
+        #expect(computed == ["a", "b", "c", "b", "c"])
+
+        let statistics = cache.statistics()
+        #expect(statistics.hits == 2)
+        #expect(statistics.misses == 5)
+        #expect(statistics.evictions == 3)
+        #expect(statistics.count == 2)
+        #expect(statistics.capacity == 2)
+        #expect(abs(statistics.hitRate - 2.0 / 7.0) < 1e-12)
+
+        cache.removeAll()
+        #expect(cache.statistics().count == 0)
+        #expect(cache.statistics().hits == 0)
+        #expect(Self.lookup(Self.key("a"), in: cache, computed: &computed) == "a")
+        #expect(computed.last == "a")
+    }
+
+    @Test("Нулевая емкость отключает кеш")
+    func testDisabled() {
+        let cache = G2PWordCache(capacity: 0)
+        var computed: [String] = []
+        for _ in 0..<3 {
+            _ = Self.lookup(Self.key("read"), in: cache, computed: &computed)
+        }
+        #expect(computed == ["read", "read", "read"])
+        #expect(cache.statistics().count == 0)
+        #expect(cache.statistics().hitRate == 0)
+    }
+
+    @Test("Ключи, различающиеся одним полем, не совпадают")
+    func testKeyFields() {
+        let base = Self.key("read", tag: "VBD")
+        let variants = [
+            Self.key("read", tag: "VBP"),
+            Self.key("read", tag: "VBD", underscore: MToken.Underscore(stress: 1)),
+            Self.key("read", tag: "VBD", underscore: MToken.Underscore(isHead: false)),
+            Self.key("read", tag: "VBD", underscore: MToken.Underscore(currency: "$")),
+            Self.key("read", tag: "VBD", underscore: MToken.Underscore(numFlags: "&")),
+            Self.key("read", tag: "VBD", underscore: MToken.Underscore(alias: "red")),
+            Self.key("read", tag: "VBD", context: TokenContext(futureVowel: true)),
+            Self.key("read", tag: "VBD", context: TokenContext(futureVowel: false)),
+            Self.key("read", tag: "VBD", context: TokenContext(futureTo: true))
+        ]
+        #expect(Set(variants + [base]).count == variants.count + 1)
+
+        // Каждый вариант вычисляется заново, а не берется из записи base
+        let cache = G2PWordCache(capacity: 16)
+        var computed: [String] = []
+        for key in [base] + variants {
+            _ = Self.lookup(key, in: cache, computed: &computed)
+        }
+        #expect(computed.count == variants.count + 1)
+        #expect(cache.statistics().hits == 0)
+    }
+
+    @Test("Фонемы с кешем и без совпадают с лексиконом")
+    func testMatchesLexicon() {
+        let lexicon = Lexicon(british: false, golds: [
+            "read": ["DEFAULT": "ɹˈid", "VBD": "ɹˈɛd"],
+            "the": "ðə",
+            "to": "tʊ",
+            "hello": "həlˈO"
+        ], silvers: [:])
+        let underscores = [
+            MToken.Underscore(),
+            MToken.Underscore(stress: -1),
+            MToken.Underscore(stress: 2),
+            MToken.Underscore(isHead: false),
+            MToken.Underscore(currency: "$")
+        ]
+        let contexts = [TokenContext(), TokenContext(futureVowel: true), TokenContext(futureVowel: false), TokenContext(futureTo: true)]
+        var cases: [(MToken, TokenContext)] = []
+        for text in ["read", "the", "to", "Hello", "12", "1990s"] {
+            for tag in ["VBD", "NN"] {
+                for underscore in underscores {
+                    for context in contexts {
+                        cases.append((MToken(text: text, tag: tag, underscore: underscore), context))
+                    }
+                }
+            }
+        }
+
+        let enabled = G2PWordCache(capacity: cases.count)
+        let disabled = G2PWordCache(capacity: 0)
+        // Два прохода: второй читает все из кеша
+        for _ in 0..<2 {
+            for (token, context) in cases {
+                let expected = lexicon.processToken(token, context: context)
+                let cached = enabled.processToken(token, context: context, in: lexicon)
+                let uncached = disabled.processToken(token, context: context, in: lexicon)
+                #expect(cached.0 == expected.0 && cached.1 == expected.1, "\(token.text) \(token.tag)")
+                #expect(uncached.0 == expected.0 && uncached.1 == expected.1, "\(token.text) \(token.tag)")
+            }
+        }
+        #expect(enabled.statistics().hits == cases.count)
+        #expect(disabled.statistics().hits + disabled.statistics().misses == 0)
+    }
+}
@@ -0,0 +1,76 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты корзин длин входа
+struct LengthBucketsTests {
+
+    @Test("Выбор наименьшей подходящей корзины")
+    func testBucketSelection() {
+        let buckets = LengthBuckets(tokens: [64, 32, 32, 0, 128], frames: [256])
+
+        #expect(buckets.tokens == [32, 64, 128])
+        #expect(buckets.tokenBucket(for: 5) == 32)
+        #expect(buckets.tokenBucket(for: 32) == 32)
+        #expect(buckets.tokenBucket(for: 33) == 64)
+        // Длиннее всех корзин - без дополнения
+        #expect(buckets.tokenBucket(for: 200) == 200)
+        #expect(buckets.frameBucket(for: 300) == 300)
+
+        #expect(!LengthBuckets.none.isEnabled)
+        #expect(LengthBuckets.none.tokenBucket(for: 17) == 17)
+        #expect(LengthBuckets.none.cacheTag.isEmpty)
+        #expect(LengthBuckets.standard.cacheTag != buckets.cacheTag)
+    }
+
+    @Test("Распределение по корзинам и накладные расходы дополнения")
+    func testStatistics() {
+        let buckets = LengthBuckets(tokens: [32, 64], frames: [100, 200])
+        let statistics = LengthBucketStatistics()
+
+        for (tokens, frames) in [(20, 60), (30, 90), (50, 150), (80, 260)] {
+            let trace = InferenceTrace(tokens: tokens)
+            trace.frames = frames
+            let paddedTokens = buckets.tokenBucket(for: tokens)
+            let paddedFrames = buckets.frameBucket(for: frames)
+            trace.paddedTokens = paddedTokens == tokens ? nil : paddedTokens
+            trace.paddedFrames = paddedFrames == frames ? nil : paddedFrames
+            statistics.record(trace, buckets: buckets)
+        }
+        // Без длительностей инференс не дошёл до выравнивания и не учитывается
+        statistics.record(InferenceTrace(tokens: 10), buckets: buckets)
+
+        let report = statistics.report()
+        #expect(report.inferences == 4)
+        #expect(report.tokenHits == [32: 2, 64: 1, 80: 1])
+        #expect(report.frameHits == [100: 2, 200: 1, 260: 1])
+        #expect(report.tokenOverflows == 1)
+        #expect(report.frameOverflows == 1)
+        #expect(report.tokens == 180)
+        #expect(report.paddedTokens == 208)
+        #expect(abs(report.tokenPaddingOverhead - 28.0 / 180.0) < 1e-9)
+
+        statistics.reset()
+        #expect(statistics.report().inferences == 0)
+    }
+
+    @Test("Бенчмарк: число различных форм входа на типичном трафике", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkShapeFragmentation() {
+        var random = SplitMix64(seed: 7)
+        let lengths = (0..<10_000).map { _ in Int(random.next() % 300) + 3 }
+        let statistics = LengthBucketStatistics()
+        let seconds = Benchmark.seconds {
+            for tokens in lengths {
+                let trace = InferenceTrace(tokens: tokens)
+                trace.frames = tokens * 3
+                let padded = LengthBuckets.standard.tokenBucket(for: tokens)
+                trace.paddedTokens = padded
+                trace.paddedFrames = LengthBuckets.standard.frameBucket(for: tokens * 3)
+                statistics.record(trace, buckets: .standard)
+            }
+        }
+        let report = statistics.report()
+        let rawShapes = Set(lengths).count
+        print("📊 Форм входа: \(rawShapes) -> \(report.tokenHits.count), дополнение токенов +\(String(format: "%.0f", report.tokenPaddingOverhead * 100))%, \(String(format: "%.2f", seconds * 1000)) мс")
+    }
+}
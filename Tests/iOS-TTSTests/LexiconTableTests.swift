@@ -0,0 +1,138 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты компактного словаря фонем
+struct LexiconTableTests {
+
+    private static var sample: [String: Any] {
+        return [
+            "hello": "həlˈO",
+            "Paris": "pˈæɹɪs",
+            "read": ["DEFAULT": "ɹˈid", "VBD": "ɹˈɛd", "VBN": "ɹˈɛd"],
+            "used": ["DEFAULT": "jˈuzd", "VBD": "jˈust", "None": NSNull()],
+            "a": "ˈA",
+            "NASA": "nˈæsə"
+        ]
+    }
+
+    @Test("Точное совпадение и регистровые варианты как в grow_dictionary")
+    func testCaseVariants() {
+        let table = LexiconTable(Self.sample)
+
+        #expect(table["hello"] == .single("həlˈO"))
+        #expect(table["Hello"] == .single("həlˈO"))    // lowercase -> Capitalized
+        #expect(table["paris"] == .single("pˈæɹɪs"))   // Capitalized -> lowercase
+        #expect(table["HELLO"] == nil)                 // верхний регистр не расширяется
+        #expect(table["A"] == nil)                     // ключи короче 2 символов не расширяются
+        #expect(table["nasa"] == nil)
+        #expect(table.count == Self.sample.count)
+    }
+
+    @Test("Те же ключи и фонемы, что у словаря после grow_dictionary")
+    func testMatchesLegacy() {
+        let table = LexiconTable(Self.sample)
+        let legacy = LegacyLexicon.growDictionary(Self.sample)
+
+        for key in Self.sample.keys {
+            for word in [key, key.lowercased(), key.capitalized, key.uppercased()] {
+                #expect((table[word] != nil) == (legacy[word] != nil), "\(word)")
+                if let phonemes = legacy[word] as? String {
+                    #expect(table[word] == .single(phonemes), "\(word)")
+                }
+            }
+        }
+    }
+
+    @Test("Варианты по POS-тегу")
+    func testPOSVariants() {
+        let table = LexiconTable(Self.sample)
+
+        guard case .variants(let read)? = table["read"] else {
+            Issue.record("read должен быть гетеронимом")
+            return
+        }
+        #expect(read["VBD"] == .some("ɹˈɛd"))
+        #expect(read["NN"] == nil)
+        #expect(read.contains("DEFAULT"))
+
+        guard case .variants(let used)? = table["used"] else {
+            Issue.record("used должен быть гетеронимом")
+            return
+        }
+        // null в JSON - тег присутствует, но фонем нет
+        #expect(used["None"] == .some(nil))
+    }
+
+    @Test("Lexicon использует варианты по тегу")
+    func testLexiconLookup() {
+        let lexicon = Lexicon(british: false, golds: Self.sample, silvers: [:])
+
+        #expect(lexicon.lookup("read", tag: "VBD", stress: nil, context: TokenContext(futureVowel: false)).0 == "ɹˈɛd")
+        #expect(lexicon.lookup("read", tag: "NN", stress: nil, context: TokenContext(futureVowel: false)).0 == "ɹˈid")
+        #expect(lexicon.lookup("Hello", tag: "UH", stress: nil, context: TokenContext()).0 == "həlˈO")
+        #expect(lexicon.isKnown("Paris", tag: nil))
+    }
+
+    @Test("Бенчмарк: LexiconTable против [String: Any]", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkLookups() {
+        // Синтетический словарь порядка реального gold (~90k ключей)
+        var dict: [String: Any] = [:]
+        for i in 0..<90_000 {
+            let word = "w\(String(i, radix: 36))"
+            if i % 50 == 0 {
+                dict[word] = ["DEFAULT": "wˈɜɹd\(i % 97)", "VBD": "wˈɜɹt\(i % 97)"]
+            } else {
+                dict[i % 3 == 0 ? word.capitalized : word] = "wˈɜɹd\(i % 997)ɪŋ"
+            }
+        }
+        let queries = (0..<10_000).map { i -> String in
+            let word = "w\(String((i * 7919) % 90_000, radix: 36))"
+            return i % 4 == 0 ? word.capitalized : word
+        }
+
+        let baseline = Benchmark.residentMemoryBytes()
+        let legacy = LegacyLexicon.growDictionary(dict)
+        let legacyMemory = Benchmark.residentMemoryBytes() &- baseline
+        var legacyHits = 0
+        let legacyRate = Benchmark.throughput(iterations: 20) {
+            for word in queries {
+                if let value = legacy[word] {
+                    if value is String || (value as? [String: Any])?["DEFAULT"] is String {
+                        legacyHits += 1
+                    }
+                }
+            }
+        }
+
+        let tableBaseline = Benchmark.residentMemoryBytes()
+        let table = LexiconTable(dict)
+        let tableMemory = Benchmark.residentMemoryBytes() &- tableBaseline
+        var tableHits = 0
+        let tableRate = Benchmark.throughput(iterations: 20) {
+            for word in queries where table[word] != nil {
+                tableHits += 1
+            }
+        }
+
+        print("📊 [String: Any]: \(Int(legacyRate) * queries.count) lookups/s, entries=\(legacy.count), hits=\(legacyHits), memory≈\(Benchmark.format(bytes: legacyMemory))")
+        print("📊 LexiconTable:  \(Int(tableRate) * queries.count) lookups/s, entries=\(table.count), hits=\(tableHits), memory≈\(Benchmark.format(bytes: tableMemory)), index=\(table.indexBytes) bytes")
+    }
+}
+
+/// Прежнее представление словаря - эталон для сравнения
+private enum LegacyLexicon {
+    static func growDictionary(_ dict: [String: Any]) -> [String: Any] {
+        var extended: [String: Any] = [:]
+        for (key, value) in dict where key.count >= 2 {
+            if key == key.lowercased() {
+                if key != key.capitalized {
+                    extended[key.capitalized] = value
+                }
+            } else if key == key.lowercased().capitalized {
+                extended[key.lowercased()] = value
+            }
+        }
+        return extended.merging(dict) { (_, new) in new }
+    }
+}
@@ -0,0 +1,104 @@
+import Testing
+import Foundation
+import CoreML
+import Accelerate
+@testable import iOS_TTS
+
+/// Тесты страйдовых представлений матриц и выравнивания через gather
+struct MatrixViewTests {
+
+    private static func array(rows: Int, columns: Int, seed: UInt64) throws -> MLMultiArray {
+        var random = SplitMix64(seed: seed)
+        let array = try MLMultiArray(shape: [1, NSNumber(value: rows), NSNumber(value: columns)], dataType: .float32)
+        let pointer = array.dataPointer.bindMemory(to: Float.self, capacity: array.count)
+        for i in 0..<array.count {
+            pointer[i] = Float(random.next() % 2001) / 1000 - 1
+        }
+        return array
+    }
+
+    /// Прежний путь: явная one-hot матрица выравнивания и GEMM
+    private static func alignWithMatrix(_ input: [Float], rows: Int, seqLen: Int, indices: [Int], columns: Int) -> [Float] {
+        var alignment = [Float](repeating: 0, count: seqLen * columns)
+        for (frame, token) in indices.enumerated() {
+            alignment[token * columns + frame] = 1
+        }
+        var result = [Float](repeating: 0, count: rows * columns)
+        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, Int32(rows), Int32(columns), Int32(seqLen),
+                    1, input, Int32(seqLen), alignment, Int32(columns), 0, &result, Int32(columns))
+        return result
+    }
+
+    private static func indices(seqLen: Int, framesPerToken: Int) -> [Int] {
+        return (0..<seqLen).flatMap { token in Array(repeating: token, count: 1 + token % framesPerToken) }
+    }
+
+    @Test("Транспонированное представление без копирования")
+    func testTransposedArray() throws {
+        let source = try Self.array(rows: 3, columns: 5, seed: 1)
+        let transposed = try MatrixView.transposedArray(source)
+
+        #expect(transposed.shape == [1, 5, 3])
+        #expect(transposed.dataPointer == source.dataPointer)
+        for row in 0..<3 {
+            for column in 0..<5 {
+                #expect(transposed[[0, column as NSNumber, row as NSNumber]] == source[[0, row as NSNumber, column as NSNumber]])
+            }
+        }
+        #expect(throws: TTSError.self) { _ = try MatrixView(MLMultiArray(shape: [2, 3], dataType: .float32)) }
+    }
+
+    @Test("Gather совпадает с умножением на матрицу выравнивания", arguments: [false, true])
+    func testGatherMatchesGEMM(transposedInput: Bool) throws {
+        let hidden = 16
+        let seqLen = 9
+        let indices = Self.indices(seqLen: seqLen, framesPerToken: 4)
+        let columns = indices.count + 5
+
+        // d хранится как [seqLen, hidden] и читается транспонированным, t_en - как [hidden, seqLen]
+        let source = transposedInput
+            ? try Self.array(rows: seqLen, columns: hidden, seed: 2)
+            : try Self.array(rows: hidden, columns: seqLen, seed: 3)
+        let view = transposedInput ? try MatrixView(source).transposed : try MatrixView(source)
+        let dense = (0..<hidden).flatMap { row in (0..<seqLen).map { view[row, $0] } }
+        let expected = Self.alignWithMatrix(dense, rows: hidden, seqLen: seqLen, indices: indices, columns: columns)
+
+        var output = [Float](repeating: .nan, count: hidden * columns)
+        let bytes = output.withUnsafeMutableBufferPointer { view.gatherColumns(indices, outputColumns: columns, into: $0.baseAddress!) }
+
+        #expect(output == expected)
+        #expect(bytes == hidden * columns * MemoryLayout<Float>.size)
+    }
+
+    @Test("Пустые длительности дают нулевой результат")
+    func testEmptyIndices() throws {
+        let view = try MatrixView(Self.array(rows: 4, columns: 3, seed: 4))
+        var output = [Float](repeating: .nan, count: 4 * 2)
+        _ = output.withUnsafeMutableBufferPointer { view.gatherColumns([], outputColumns: 2, into: $0.baseAddress!) }
+        #expect(output.allSatisfy { $0 == 0 })
+    }
+
+    @Test("Бенчмарк: выравнивание через gather против транспонирования и GEMM", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkAlignment() throws {
+        let hidden = 640
+        let seqLen = 200
+        let indices = Self.indices(seqLen: seqLen, framesPerToken: 6)
+        let d = try Self.array(rows: seqLen, columns: hidden, seed: 5)
+        let view = try MatrixView(d).transposed
+        var output = [Float](repeating: 0, count: hidden * indices.count)
+
+        let gatherSeconds = Benchmark.seconds {
+            for _ in 0..<10 {
+                _ = output.withUnsafeMutableBufferPointer { view.gatherColumns(indices, outputColumns: indices.count, into: $0.baseAddress!) }
+            }
+        }
+        let dense = (0..<hidden).flatMap { row in (0..<seqLen).map { view[row, $0] } }
+        let gemmSeconds = Benchmark.seconds {
+            for _ in 0..<10 {
+                _ = Self.alignWithMatrix(dense, rows: hidden, seqLen: seqLen, indices: indices, columns: indices.count)
+            }
+        }
+        let saved = (seqLen * indices.count + hidden * seqLen) * MemoryLayout<Float>.size
+        print("📊 Выравнивание \(seqLen) токенов / \(indices.count) кадров: gather \(String(format: "%.2f", gatherSeconds * 100)) мс, GEMM \(String(format: "%.2f", gemmSeconds * 100)) мс, без копий \(Benchmark.format(bytes: UInt64(saved)))")
+    }
+}
@@ -0,0 +1,109 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты ленивой загрузки и выгрузки подмоделей
+struct ModelResidencyTests {
+
+    /// Заменяет модель: считает загрузки
+    private final class Counter: @unchecked Sendable {
+        private let lock = NSLock()
+        private(set) var loads = 0
+
+        func load() -> [Float] {
+            lock.lock()
+            loads += 1
+            lock.unlock()
+            return [Float](repeating: 1, count: 1024)
+        }
+    }
+
+    private static let lazy = ModelResidencyPolicy(loadOnFirstUse: true, idleTimeout: nil, unloadOnMemoryWarning: false)
+
+    @Test("Загрузка при первом использовании, повторно - из памяти")
+    func testLoadOnFirstUse() throws {
+        let manager = ModelResidencyManager(policy: Self.lazy)
+        let counter = Counter()
+        let resource = manager.register(name: "Decoder", bytes: 4096) { counter.load() }
+
+        #expect(!resource.isResident)
+        #expect(manager.residentBytes == 0)
+        _ = try resource.get()
+        _ = try resource.get()
+        #expect(counter.loads == 1)
+        #expect(manager.residentBytes == 4096)
+
+        let entry = try #require(manager.report().first)
+        #expect(entry.name == "Decoder")
+        #expect(entry.isResident)
+        #expect(entry.loads == 1)
+    }
+
+    @Test("Выгружаются только простаивающие модели")
+    func testIdleEviction() throws {
+        let manager = ModelResidencyManager(policy: Self.lazy)
+        let counter = Counter()
+        let idle = manager.register(name: "Albert", bytes: 100) { counter.load() }
+        let busy = manager.register(name: "Generator", bytes: 200) { counter.load() }
+        _ = try idle.get()
+        Thread.sleep(forTimeInterval: 0.05)
+        _ = try busy.get()
+
+        #expect(manager.unloadIdle(for: 0.03) == 100)
+        #expect(!idle.isResident)
+        #expect(busy.isResident)
+
+        // Следующее обращение загружает модель заново
+        _ = try idle.get()
+        #expect(counter.loads == 3)
+        #expect(manager.report().first { $0.name == "Albert" }?.evictions == 1)
+    }
+
+    @Test("Предупреждение о памяти выгружает всё, кроме переданных готовыми")
+    func testMemoryWarning() throws {
+        let manager = ModelResidencyManager(policy: .onDemand)
+        let counter = Counter()
+        let lazy = manager.register(name: "Decoder", bytes: 300) { counter.load() }
+        let fixed = ResidentResource(name: "Generator", resident: [Float](repeating: 0, count: 4))
+        _ = try lazy.get()
+
+        manager.handleMemoryWarning()
+        #expect(!lazy.isResident)
+        #expect(fixed.isResident)
+        #expect(fixed.evict(idleFor: 0) == 0)
+    }
+
+    @Test("Предзагрузка и слабые ссылки на записи")
+    func testPrefetch() throws {
+        let manager = ModelResidencyManager(policy: Self.lazy)
+        let counter = Counter()
+        let resources = ["Albert", "Decoder", "Generator"].map { name in
+            manager.register(name: name, bytes: 10) { counter.load() }
+        }
+        try manager.load(resources)
+        #expect(resources.allSatisfy(\.isResident))
+        #expect(counter.loads == 3)
+        // Только что загруженные заранее модели не простаивают
+        #expect(manager.unloadIdle(for: 60) == 0)
+        #expect(resources.allSatisfy(\.isResident))
+
+        var dropped: ResidentResource<[Float]>? = manager.register(name: "POSTagger", bytes: 10) { counter.load() }
+        #expect(manager.report().count == 4)
+        dropped = nil
+        #expect(dropped == nil)
+        #expect(manager.report().count == 3)
+    }
+
+    @Test("Бенчмарк: обращение к загруженной модели", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkResidentAccess() throws {
+        let manager = ModelResidencyManager(policy: Self.lazy)
+        let counter = Counter()
+        let resource = manager.register(name: "Decoder", bytes: 10) { counter.load() }
+        _ = try resource.get()
+
+        let perSecond = Benchmark.throughput(iterations: 100_000) {
+            _ = try? resource.get()
+        }
+        print("📊 Обращений к модели в секунду: \(String(format: "%.0f", perSecond))")
+    }
+}
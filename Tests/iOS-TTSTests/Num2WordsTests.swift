@@ -0,0 +1,108 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты табличного Num2Words и чисел в лексиконе
+struct Num2WordsTests {
+
+    /// Словарь, где фонемы числительного - само слово с ударением
+    private static let lexicon: Lexicon = {
+        var golds: [String: Any] = ["dollar": "ˈdollar", "cent": "ˈcent"]
+        for word in Num2Words.Word.allCases where word != .bc {
+            golds[word.text] = "ˈ" + word.text
+        }
+        return Lexicon(british: false, golds: golds, silvers: [:])
+    }()
+
+    @Test("Строковые формы")
+    func testStrings() {
+        #expect(Num2Words.cardinal(0) == "zero")
+        #expect(Num2Words.cardinal(-42) == "minus forty-two")
+        #expect(Num2Words.cardinal(1_234) == "one thousand two hundred and thirty-four")
+        #expect(Num2Words.cardinal(2_000_005) == "two million and five")
+        #expect(Num2Words.ordinal(0) == "zeroth")
+        #expect(Num2Words.ordinal(21) == "twenty-first")
+        #expect(Num2Words.ordinal(100) == "one hundredth")
+        #expect(Num2Words.year(1905) == "nineteen oh five")
+        #expect(Num2Words.year(1900) == "nineteen hundred")
+        #expect(Num2Words.year(1999) == "nineteen ninety-nine")
+        #expect(Num2Words.year(2005) == "two thousand and five")
+        #expect(Num2Words.float(3.5) == "three point five")
+        #expect(Num2Words.float(3.05) == "three point zero five")
+        #expect(Num2Words.float(3.0) == "three")
+        #expect(Num2Words.float(1e-5) == "zero point zero zero zero zero one")
+        #expect(Num2Words.float(-2.5e-7) == "minus zero point zero zero zero zero zero zero two five")
+        #expect(Num2Words.float(1e20) == "one hundred billion billion")
+        #expect(Num2Words.digits("555-0199") == "five five five zero one nine nine")
+    }
+
+    @Test("Слова пишутся в переданный буфер")
+    func testBuffer() {
+        var words: [Num2Words.Word] = []
+        Num2Words.cardinal(15, into: &words)
+        Num2Words.decimal("0.25", into: &words)
+        #expect(words == [.fifteen, .zero, .point, .two, .five])
+        #expect(!Num2Words.decimal("1.2.3", into: &words))
+    }
+
+    @Test("Буфер слов совпадает со строковой формой")
+    func testBufferMatchesStrings() {
+        var words: [Num2Words.Word] = []
+        for number in [0, 7, 13, 40, 99, 101, 1_000, 1_234, 20_019, 700_000, 2_000_005] {
+            words.removeAll(keepingCapacity: true)
+            Num2Words.cardinal(number, into: &words)
+            let text = Num2Words.cardinal(number).components(separatedBy: CharacterSet.letters.inverted).filter { !$0.isEmpty }
+            #expect(words.map(\.text) == text, "\(number)")
+        }
+    }
+
+    @Test("Числа в лексиконе берут фонемы из таблицы")
+    func testLexiconNumbers() {
+        func phonemes(_ text: String, currency: String? = nil) -> String? {
+            let token = MToken(text: text, tag: "CD", underscore: MToken.Underscore(currency: currency))
+            return Self.lexicon.processToken(token, context: TokenContext()).0
+        }
+
+        #expect(phonemes("1905") == "ˈnineteen ˈoh ˈfive")
+        #expect(phonemes("21st") == "ˈtwenty ˈfirst")
+        #expect(phonemes("3.05") == "ˈthree point ˈzero ˈfive")
+        // Окончание -s добавляется к фонемам единицы, а не к ее написанию
+        #expect(phonemes("5", currency: "$") == "ˈfive ˈdollarz")
+        #expect(phonemes("1", currency: "$") == "ˈone ˈdollar")
+    }
+
+    @Test("Бенчмарк: строки num2words против буфера слов", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkNumbers() {
+        let numbers = (0..<2_000).map { ($0 * 7919) % 1_000_000 }
+        let lexicon = Self.lexicon
+        let context = TokenContext()
+
+        var stringCount = 0
+        let stringRate = Benchmark.throughput(iterations: 20) {
+            for number in numbers {
+                // Прежний путь: строка, разбиение на слова и поиск каждого в словаре
+                let text = Num2Words.cardinal(number)
+                for word in text.components(separatedBy: CharacterSet.letters.inverted) where !word.isEmpty {
+                    if lexicon.lookup(word, tag: nil, stress: nil, context: context).0 != nil {
+                        stringCount += 1
+                    }
+                }
+            }
+        }
+
+        var bufferCount = 0
+        var words: [Num2Words.Word] = []
+        let bufferRate = Benchmark.throughput(iterations: 20) {
+            for number in numbers {
+                words.removeAll(keepingCapacity: true)
+                Num2Words.cardinal(number, into: &words)
+                for word in words where lexicon.lookup(word).0 != nil {
+                    bufferCount += 1
+                }
+            }
+        }
+
+        print("📊 num2words строки: \(Int(stringRate * Double(numbers.count))) чисел/с, найдено слов \(stringCount)")
+        print("📊 num2words буфер:  \(Int(bufferRate * Double(numbers.count))) чисел/с (x\(String(format: "%.1f", bufferRate / stringRate))), найдено слов \(bufferCount)")
+    }
+}
@@ -0,0 +1,121 @@
+import Testing
+import Foundation
+import CoreML
+@testable import iOS_TTS
+
+/// Тесты пула буферов для выходов моделей (без MLModel)
+struct OutputBackingPoolTests {
+
+    /// Выход [1, count] Float32 - 4 * count байт
+    private static func spec(_ name: String, count: Int) -> OutputBackingPool.OutputSpec {
+        return OutputBackingPool.OutputSpec(name: name, shape: [1, count as NSNumber], dataType: .float32)
+    }
+
+    @Test("Буфер возвращается в пул и переиспользуется следующим запросом")
+    func testReuse() throws {
+        let pool = OutputBackingPool(capacity: 4096)
+        let spec = Self.spec("audio", count: 100)
+
+        let first = BackingLease()
+        let firstArray = try #require(try pool.takeBuffers(for: [spec], lease: first)["audio"] as? MLMultiArray)
+        #expect(pool.statistics().pooledBytes == 0)
+        pool.finish(first)
+        #expect(pool.statistics().pooledBytes == 400)
+
+        let second = BackingLease()
+        let secondArray = try #require(try pool.takeBuffers(for: [spec], lease: second)["audio"] as? MLMultiArray)
+        #expect(secondArray === firstArray)
+        #expect(second.reusedBytes == 400)
+        pool.finish(second)
+
+        let statistics = pool.statistics()
+        #expect(statistics.requests == 2)
+        #expect(statistics.hits == 1)
+        #expect(statistics.misses == 1)
+        #expect(statistics.reusedBytes == 400)
+        #expect(statistics.lastRequestReusedBytes == 400)
+        #expect(statistics.pooledBytes == 400)
+    }
+
+    @Test("Буферы одного запроса не делятся, форма другого размера - промах")
+    func testShapes() throws {
+        let pool = OutputBackingPool(capacity: 4096)
+        let warm = BackingLease()
+        _ = try pool.takeBuffers(for: [Self.spec("a", count: 100)], lease: warm)
+        pool.finish(warm)
+
+        let lease = BackingLease()
+        let backings = try pool.takeBuffers(for: [Self.spec("a", count: 100), Self.spec("b", count: 100), Self.spec("c", count: 50)], lease: lease)
+        #expect((backings["a"] as? MLMultiArray) !== (backings["b"] as? MLMultiArray))
+        #expect(lease.reusedBytes == 400)
+        pool.finish(lease)
+
+        let statistics = pool.statistics()
+        #expect(statistics.hits == 1)
+        #expect(statistics.misses == 3)
+        #expect(statistics.pooledBytes == 1000)
+    }
+
+    @Test("Сверх capacity вытесняются давно возвращенные буферы")
+    func testCapacityEviction() throws {
+        let pool = OutputBackingPool(capacity: 1000)
+        let old = BackingLease()
+        let oldArray = try #require(try pool.takeBuffers(for: [Self.spec("old", count: 100)], lease: old)["old"] as? MLMultiArray)
+        pool.finish(old)
+
+        let lease = BackingLease()
+        _ = try pool.takeBuffers(for: [Self.spec("x", count: 150), Self.spec("y", count: 150)], lease: lease)
+        pool.finish(lease)
+        // 400 + 600 + 600 байт: вытесняются "old" и "x", возвращенные раньше
+        #expect(pool.statistics().pooledBytes == 600)
+
+        let next = BackingLease()
+        let array = try #require(try pool.takeBuffers(for: [Self.spec("old", count: 100)], lease: next)["old"] as? MLMultiArray)
+        #expect(array !== oldArray)
+        #expect(next.reusedBytes == 0)
+    }
+
+    @Test("purge и выключение освобождают простаивающие буферы")
+    func testPurge() throws {
+        let pool = OutputBackingPool(capacity: 4096)
+        let lease = BackingLease()
+        _ = try pool.takeBuffers(for: [Self.spec("audio", count: 100)], lease: lease)
+        pool.finish(lease)
+
+        pool.purge()
+        #expect(pool.statistics().pooledBytes == 0)
+
+        let held = BackingLease()
+        _ = try pool.takeBuffers(for: [Self.spec("audio", count: 100)], lease: held)
+        pool.isEnabled = false
+        #expect(!pool.isEnabled)
+        // Буферы запроса, начатого до выключения, в пул уже не возвращаются
+        pool.finish(held)
+        #expect(pool.statistics().pooledBytes == 0)
+        #expect(pool.statistics().requests == 2)
+    }
+
+    @Test("Предупреждение о памяти и unloadAll очищают пул при любой политике")
+    func testResidencyPurge() throws {
+        for policy in [ModelResidencyPolicy.resident, .onDemand] {
+            let manager = ModelResidencyManager(policy: policy)
+            let pool = OutputBackingPool()
+            manager.addPurgeHandler { [pool] in
+                pool.purge()
+            }
+            let fill = {
+                let lease = BackingLease()
+                _ = try pool.takeBuffers(for: [Self.spec("audio", count: 100)], lease: lease)
+                pool.finish(lease)
+            }
+
+            try fill()
+            manager.handleMemoryWarning()
+            #expect(pool.statistics().pooledBytes == 0)
+
+            try fill()
+            manager.unloadAll()
+            #expect(pool.statistics().pooledBytes == 0)
+        }
+    }
+}
@@ -0,0 +1,30 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты упаковки предложений в батчи POS-теггера
+struct POSTagBatcherTests {
+
+    @Test("Упаковка по бюджету символов и числу предложений")
+    func testPack() {
+        let texts = ["Hello there.", "How are you?", String(repeating: "a", count: 40), "Bye."]
+        #expect(POSTagBatcher.pack(texts, maxCharacters: 30, maxSentences: 16) == [0..<2, 2..<3, 3..<4])
+        #expect(POSTagBatcher.pack(texts, maxCharacters: 1_000, maxSentences: 3) == [0..<3, 3..<4])
+        #expect(POSTagBatcher.pack([]).isEmpty)
+    }
+
+    @Test("Теги раскладываются по предложениям по совпадению символов")
+    func testScatter() {
+        let texts: ArraySlice<String> = ["I read it.", "Don't  stop!"]
+        let pairs = [("I", "PRP"), ("read", "VBD"), ("it", "PRP"), (".", "."),
+                     ("Do", "VBP"), ("n't", "RB"), ("stop", "VB"), ("!", ".")]
+
+        let scattered = POSTagBatcher.scatter(pairs, over: texts)
+        #expect(scattered?.map { $0.map(\.0) } == [["I", "read", "it", "."], ["Do", "n't", "stop", "!"]])
+        #expect(scattered?[0][1].1 == "VBD")
+
+        // Токен через границу предложений или лишний токен - батч отбрасывается
+        #expect(POSTagBatcher.scatter([("I", "PRP"), ("read", "VBD"), ("it.Don't", "NN"), ("stop", "VB"), ("!", ".")], over: texts) == nil)
+        #expect(POSTagBatcher.scatter(pairs + [("extra", "NN")], over: texts) == nil)
+    }
+}
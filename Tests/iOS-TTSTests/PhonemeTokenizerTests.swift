@@ -0,0 +1,45 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты токенизатора фонем
+struct PhonemeTokenizerTests {
+
+    private let vocab: [String: Int] = ["<pad>": 0, "<unk>": 1, "h": 50, "ə": 83, "l": 54, "ˈ": 156, "O": 31, " ": 16]
+
+    @Test("Кодирование с паддингом и неизвестными символами")
+    func testEncode() {
+        let tokenizer = PhonemeTokenizer(vocab: vocab)
+
+        #expect(tokenizer.encode("həlˈO") == [0, 50, 83, 54, 156, 31, 0])
+        #expect(tokenizer.encode("h❓ɫ") == [0, 50, 1, 1, 0])
+        #expect(tokenizer.encode("") == [0, 0])
+
+        let report = tokenizer.report
+        #expect(report.tokens == 8)
+        #expect(report.unknownTokens == 2)
+        #expect(report.unknownScalars["❓"] == 1)
+    }
+
+    @Test("Запись напрямую в input_ids")
+    func testMakeInputIdsArray() throws {
+        let tokenizer = PhonemeTokenizer(vocab: vocab)
+        let array = try tokenizer.makeInputIdsArray(for: "hə lO")
+
+        #expect(array.shape == [1, 7])
+        #expect(array[[0, 3]].floatValue == 16)
+        #expect(array[[0, 6]].floatValue == 0)
+    }
+
+    @Test("Дополнение input_ids до длины корзины")
+    func testPaddedInputIdsArray() throws {
+        let tokenizer = PhonemeTokenizer(vocab: vocab)
+        let array = try tokenizer.makeInputIdsArray(for: "həl", length: 8)
+
+        #expect(array.shape == [1, 8])
+        #expect(array[[0, 1]].floatValue == 50)
+        #expect((4..<8).allSatisfy { array[[0, $0 as NSNumber]].floatValue == 0 })
+        // Длина меньше последовательности не обрезает её
+        #expect(try tokenizer.makeInputIdsArray(for: "həl", length: 2).shape == [1, 5])
+    }
+}
@@ -0,0 +1,78 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты полифазного ресемплера
+struct ResamplerTests {
+
+    private static func sine(frequency: Double, rate: Int, count: Int) -> [Float] {
+        return (0..<count).map { Float(sin(2 * Double.pi * frequency * Double($0) / Double(rate))) }
+    }
+
+    private static func resample(_ input: [Float], to rate: Int, chunk: Int) throws -> [Float] {
+        var resampler = try PolyphaseResampler(inputRate: TTSPipeline.sampleRate, outputRate: rate)
+        var output: [Float] = []
+        var offset = 0
+        input.withUnsafeBufferPointer { input in
+            while offset < input.count {
+                let end = min(offset + chunk, input.count)
+                resampler.process(UnsafeBufferPointer(rebasing: input[offset..<end]), into: &output)
+                offset = end
+            }
+        }
+        resampler.flush(into: &output)
+        return output
+    }
+
+    @Test("Синус сохраняет частоту и фазу", arguments: [8_000, 16_000, 22_050, 44_100, 48_000])
+    func testSine(rate: Int) throws {
+        let input = Self.sine(frequency: 1_000, rate: TTSPipeline.sampleRate, count: 4_800)
+        let output = try Self.resample(input, to: rate, chunk: 4_800)
+        let expected = Self.sine(frequency: 1_000, rate: rate, count: output.count)
+
+        #expect(output.count == (4_800 * rate + TTSPipeline.sampleRate - 1) / TTSPipeline.sampleRate)
+        // Края искажены окном фильтра, сравниваем середину
+        let middle = (output.count / 4)..<(output.count * 3 / 4)
+        let maxError = middle.map { abs(output[$0] - expected[$0]) }.max() ?? 0
+        #expect(maxError < 0.01, "rate \(rate): \(maxError)")
+    }
+
+    @Test("Чанки любого размера дают тот же результат")
+    func testChunking() throws {
+        let input = Self.sine(frequency: 440, rate: TTSPipeline.sampleRate, count: 3_001)
+        let whole = try Self.resample(input, to: 44_100, chunk: input.count)
+        for chunk in [1, 7, 256] {
+            let chunked = try Self.resample(input, to: 44_100, chunk: chunk)
+            #expect(chunked.count == whole.count)
+            #expect(zip(chunked, whole).allSatisfy { abs($0 - $1) < 1e-6 })
+        }
+    }
+
+    @Test("Параметры банка фильтров")
+    func testConfiguration() throws {
+        let resampler = try PolyphaseResampler(inputRate: 24_000, outputRate: 44_100)
+        #expect(resampler.interpolation == 147)
+        #expect(resampler.decimation == 80)
+        #expect(throws: TTSError.self) { try PolyphaseResampler(inputRate: 24_000, outputRate: 44_101) }
+        #expect(throws: TTSError.self) { try PolyphaseResampler(inputRate: 24_000, outputRate: 0) }
+    }
+
+    @Test("Банк фильтров проектируется один раз на отношение частот")
+    func testSharedBanks() {
+        let bank = FilterBank.shared(interpolation: 147, decimation: 80)
+        #expect(FilterBank.shared(interpolation: 147, decimation: 80) === bank)
+        #expect(FilterBank.shared(interpolation: 2, decimation: 3) !== bank)
+        #expect(bank.coefficients.count == bank.tapsPerPhase * 147)
+    }
+
+    @Test("Бенчмарк: скорость ресемплинга минуты аудио", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkResampling() {
+        let input = Self.sine(frequency: 440, rate: TTSPipeline.sampleRate, count: TTSPipeline.sampleRate * 60)
+        for rate in [8_000, 16_000, 44_100, 48_000] {
+            let seconds = Benchmark.seconds {
+                _ = try? Self.resample(input, to: rate, chunk: 12_000)
+            }
+            print("📊 24 кГц -> \(rate) Гц: x\(String(format: "%.0f", 60 / seconds)) реального времени")
+        }
+    }
+}
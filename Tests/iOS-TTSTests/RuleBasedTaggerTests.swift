@@ -0,0 +1,41 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты пропуска POS-теггера для однозначных предложений
+struct RuleBasedTaggerTests {
+
+    private static let lexicon = Lexicon(british: false, golds: [
+        "read": ["DEFAULT": "ɹˈid", "VBD": "ɹˈɛd"],
+        "record": ["DEFAULT": "ɹˈɛkəɹd", "VB": "ɹəkˈɔɹd"],
+        "hello": "həlˈO",
+        "the": "ðə",
+        "cat": "kˈæt",
+        "sat": "sˈæt"
+    ], silvers: [:])
+
+    @Test("Токенизация как в BasicTokenizer BERT")
+    func testTokenize() {
+        #expect(RuleBasedTagger.tokenize("Don't stop, \"Bob\"…") == ["Don", "'", "t", "stop", ",", "\"", "Bob", "\"", "…"])
+        #expect(RuleBasedTagger.tokenize("  $5.50 now ") == ["$", "5", ".", "50", "now"])
+    }
+
+    @Test("Однозначное предложение размечается правилами")
+    func testUnambiguousSentence() {
+        let pairs = RuleBasedTagger.tag("The cat sat with Bob in the hall.", lexicon: Self.lexicon)
+        #expect(pairs?.map(\.0) == ["The", "cat", "sat", "with", "Bob", "in", "the", "hall", "."])
+        #expect(pairs?.map(\.1) == ["DT", "NN", "NN", "IN", "NNP", "IN", "DT", "NN", "."])
+        #expect(RuleBasedTagger.tag("The cat sat in.", lexicon: Self.lexicon)?[3].1 == "RP")
+    }
+
+    @Test("Гетеронимы, их формы и аббревиатуры требуют теггера")
+    func testAmbiguousSentences() {
+        #expect(RuleBasedTagger.tag("I read it.", lexicon: Self.lexicon) == nil)
+        #expect(RuleBasedTagger.tag("They are recording now.", lexicon: Self.lexicon) == nil)
+        #expect(RuleBasedTagger.tag("Records matter.", lexicon: Self.lexicon) == nil)
+        #expect(RuleBasedTagger.tag("The NASA cat.", lexicon: Self.lexicon) == nil)
+        #expect(RuleBasedTagger.tag("Zorblax sat.", lexicon: Self.lexicon) == nil)   // незнакомое слово в начале
+        #expect(RuleBasedTagger.tag("A well-known cat.", lexicon: Self.lexicon) == nil)
+        #expect(RuleBasedTagger.tag("Mail me at cat@example.com", lexicon: Self.lexicon) == nil)
+    }
+}
@@ -0,0 +1,77 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты разбиения документа на предложения и параллельного доступа к лексикону
+struct SentenceSplitterTests {
+
+    @Test("Границы предложений, сокращения и markdown-ссылки")
+    func testSplit() {
+        let text = """
+        Hello there! Mr. Smith met Dr. Jones at 3.5 p.m. today. "Really?" she asked.
+        See [Kokoro](/kˈOkəɹO/. Now.) for details… The end
+        """
+        let sentences = SentenceSplitter.split(text).map(String.init)
+
+        #expect(sentences == [
+            "Hello there!",
+            "Mr. Smith met Dr. Jones at 3.5 p.m. today.",
+            "\"Really?\"",
+            "she asked.",
+            "See [Kokoro](/kˈOkəɹO/. Now.) for details…",
+            "The end"
+        ])
+        #expect(SentenceSplitter.split("   \n  ").isEmpty)
+    }
+
+    @Test("Перевод строки - граница только после пунктуации")
+    func testNewlines() {
+        let sentences = SentenceSplitter.split("Read the\napple list\nFirst, please,\nthen \"go.\"\nMr.\nSmith")
+        #expect(sentences.map(String.init) == ["Read the\napple list\nFirst, please,", "then \"go.\"", "Mr.\nSmith"])
+    }
+
+    @Test("Склейка результатов предложений сохраняет порядок")
+    func testMerge() {
+        let first = G2PResult(phonemeString: "həlˈO.", tokens: [
+            G2PTokenSpan(text: "Hello", tag: "UH", whitespace: "", phonemes: 0..<5, rating: 4),
+            G2PTokenSpan(text: ".", tag: ".", whitespace: "", phonemes: 5..<6, rating: 4)
+        ])
+        let second = G2PResult(phonemeString: "baɪ.", tokens: [
+            G2PTokenSpan(text: "Bye", tag: "UH", whitespace: "", phonemes: 0..<4, rating: 4)
+        ])
+
+        let merged = G2PEn.merge([first, second])
+        #expect(merged.phonemeString == "həlˈO. baɪ.")
+        #expect(merged.tokens.map(\.text) == ["Hello", ".", "Bye"])
+        #expect(merged.tokens[1].whitespace == " ")
+        // Диапазоны фонем сдвинуты на длину первого предложения и пробел
+        #expect(merged.tokens[2].phonemes == 7..<11)
+        let scalars = Array(merged.phonemeString.unicodeScalars)
+        #expect(String(String.UnicodeScalarView(scalars[merged.tokens[0].phonemes])) == "həlˈO")
+    }
+
+    @Test("Один Lexicon из многих задач дает те же фонемы")
+    func testConcurrentLexicon() async {
+        let lexicon = Lexicon(british: false, golds: [
+            "read": ["DEFAULT": "ɹˈid", "VBD": "ɹˈɛd"],
+            "hello": "həlˈO",
+            "the": "ðə"
+        ], silvers: [:])
+        let tokens = (0..<400).map { i in
+            MToken(text: ["read", "Hello", "the", "\(i)", "1990s"][i % 5], tag: i % 2 == 0 ? "VBD" : "NN")
+        }
+        let expected = tokens.map { lexicon.processToken($0, context: TokenContext(futureVowel: true)).0 }
+
+        let results = await withTaskGroup(of: (Int, String?).self) { group in
+            for (i, token) in tokens.enumerated() {
+                group.addTask { (i, lexicon.processToken(token, context: TokenContext(futureVowel: true)).0) }
+            }
+            var results = [String?](repeating: nil, count: tokens.count)
+            for await (i, phonemes) in group {
+                results[i] = phonemes
+            }
+            return results
+        }
+        #expect(results == expected)
+    }
+}
@@ -0,0 +1,140 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты кэша синтезированного аудио
+struct SynthesisCacheTests {
+
+    private static func temporaryDirectory() -> URL {
+        return FileManager.default.temporaryDirectory.appendingPathComponent("synthesis-cache-\(UUID().uuidString)")
+    }
+
+    private static func key(_ ids: [Int], _ options: GenerationOptions = GenerationOptions(), version: String = "v1") -> SynthesisCache.Key {
+        return SynthesisCache.key(ids: ids, options: options, modelVersion: version)
+    }
+
+    @Test("Ключ зависит от id, голоса, скорости, сида и версии модели")
+    func testKey() {
+        let base = Self.key([0, 5, 7, 0])
+        #expect(base == Self.key([0, 5, 7, 0]))
+        #expect(base != Self.key([0, 5, 8, 0]))
+        #expect(base != Self.key([0, 5, 7, 0], GenerationOptions(style: .afHeart)))
+        #expect(base != Self.key([0, 5, 7, 0], GenerationOptions(speed: 1.1)))
+        #expect(base != Self.key([0, 5, 7, 0], GenerationOptions(pitchShiftSemitones: 2)))
+        #expect(base != Self.key([0, 5, 7, 0], GenerationOptions(seed: 0)))
+        #expect(base != Self.key([0, 5, 7, 0], version: "v2"))
+        // Частота вывода и обход кэша не влияют на сегмент
+        #expect(base == Self.key([0, 5, 7, 0], GenerationOptions(outputSampleRate: 16_000, bypassCache: true)))
+    }
+
+    @Test("Память: LRU вытесняет давно не использованные сегменты")
+    func testMemoryEviction() throws {
+        let segment = [Float](repeating: 0.5, count: 1_000)
+        let cache = try SynthesisCache(memoryLimit: 3 * segment.count * 4)
+        let keys = (0..<4).map { Self.key([$0]) }
+
+        cache.insert(segment, for: keys[0])
+        cache.insert(segment, for: keys[1])
+        cache.insert(segment, for: keys[2])
+        #expect(cache.samples(for: keys[0]) != nil)
+        cache.insert(segment, for: keys[3])
+
+        #expect(cache.samples(for: keys[1]) == nil)
+        #expect(cache.samples(for: keys[0]) != nil)
+        #expect(cache.samples(for: keys[3]) != nil)
+
+        let stats = cache.statistics()
+        #expect(stats.memoryEvictions == 1)
+        #expect(stats.memoryHits == 3)
+        #expect(stats.misses == 1)
+        #expect(stats.memoryBytes == 3 * segment.count * 4)
+    }
+
+    @Test("Диск: 16-битный PCM переживает перезапуск и поднимается в память")
+    func testDiskRoundTrip() throws {
+        let directory = Self.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let segment = (0..<2_400).map { Float(sin(Double($0) * 0.05)) * 0.8 }
+        let key = Self.key([1, 2, 3])
+
+        try SynthesisCache(directory: directory).insert(segment, for: key)
+
+        let reopened = try SynthesisCache(directory: directory)
+        #expect(reopened.statistics().diskBytes == segment.count * 2)
+        let restored = try #require(reopened.samples(for: key))
+        #expect(restored.count == segment.count)
+        #expect(zip(restored, segment).allSatisfy { abs($0 - $1) <= 1.0 / 32767 })
+
+        _ = reopened.samples(for: key)
+        let stats = reopened.statistics()
+        #expect(stats.diskHits == 1)
+        #expect(stats.memoryHits == 1)
+    }
+
+    @Test("Диск: лимит вытесняет самые старые файлы")
+    func testDiskEviction() throws {
+        let directory = Self.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let segment = [Float](repeating: 0.25, count: 1_000)
+        let cache = try SynthesisCache(memoryLimit: 0, directory: directory, diskLimit: 2 * segment.count * 2)
+
+        for id in 0..<5 {
+            cache.insert(segment, for: Self.key([id]))
+        }
+
+        let stats = cache.statistics()
+        #expect(stats.diskEvictions == 3)
+        #expect(stats.diskBytes <= cache.diskLimit)
+        #expect(cache.samples(for: Self.key([4])) != nil)
+    }
+
+    @Test("Диск: параллельные вставки и очистка не сбивают счетчик байт")
+    func testConcurrentDiskBytes() throws {
+        let directory = Self.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let segment = [Float](repeating: 0.5, count: 1_000)
+        let cache = try SynthesisCache(memoryLimit: 0, directory: directory)
+
+        DispatchQueue.concurrentPerform(iterations: 64) { i in
+            cache.insert(segment, for: Self.key([i % 4]))
+            if i == 32 {
+                cache.removeAll()
+            }
+        }
+
+        let files = try FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: [.fileSizeKey])
+        let onDisk = try files.reduce(0) { $0 + (try $1.resourceValues(forKeys: [.fileSizeKey]).fileSize ?? 0) }
+        #expect(cache.statistics().diskBytes == onDisk)
+        #expect(onDisk <= 4 * segment.count * 2)
+    }
+
+    @Test("Бенчмарк: попадание в кэш против записи сегмента", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkLookup() throws {
+        let directory = Self.temporaryDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let cache = try SynthesisCache(directory: directory)
+        // Три секунды аудио на 24 кГц
+        let segment = (0..<72_000).map { Float(sin(Double($0) * 0.01)) * 0.5 }
+        let keys = (0..<50).map { Self.key([$0, 42]) }
+
+        let insertSeconds = Benchmark.seconds {
+            for key in keys {
+                cache.insert(segment, for: key)
+            }
+        }
+        var found = 0
+        let memoryRate = Benchmark.throughput(iterations: 10_000) {
+            found += cache.samples(for: keys[found % keys.count]) == nil ? 0 : 1
+        }
+        let diskCache = try SynthesisCache(memoryLimit: 0, directory: directory)
+        let diskSeconds = Benchmark.seconds {
+            for key in keys {
+                _ = diskCache.samples(for: key)
+            }
+        }
+
+        print("📊 Вставка: \(String(format: "%.2f", insertSeconds / Double(keys.count) * 1000)) мс/сегмент")
+        print("📊 Память: \(String(format: "%.0f", memoryRate)) попаданий/с")
+        print("📊 Диск: \(String(format: "%.2f", diskSeconds / Double(keys.count) * 1000)) мс/сегмент")
+    }
+}
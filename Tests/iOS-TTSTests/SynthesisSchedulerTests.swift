@@ -0,0 +1,137 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты очереди и слотов планировщика синтеза
+struct SynthesisSchedulerTests {
+
+    @Test("Сначала интерактивные, внутри класса короткие, при равенстве по порядку прихода")
+    func testOrdering() {
+        var queue = SchedulingQueue<String>()
+        queue.insert("batch-short", priority: .batch, cost: 10)
+        queue.insert("interactive-long", priority: .interactive, cost: 400)
+        queue.insert("interactive-short", priority: .interactive, cost: 50)
+        queue.insert("interactive-short-2", priority: .interactive, cost: 50)
+        queue.insert("batch-long", priority: .batch, cost: 300)
+
+        var order: [String] = []
+        while let next = queue.popFirst() {
+            order.append(next)
+        }
+        #expect(order == ["interactive-short", "interactive-short-2", "interactive-long", "batch-short", "batch-long"])
+        #expect(queue.isEmpty)
+    }
+
+    @Test("Отменённый запрос удаляется из очереди")
+    func testRemove() {
+        var queue = SchedulingQueue<Int>()
+        for id in 0..<4 {
+            queue.insert(id, priority: .batch, cost: 100 - id)
+        }
+        #expect(queue.remove(where: { $0 == 2 }) == 2)
+        #expect(queue.remove(where: { $0 == 2 }) == nil)
+        #expect(queue.count == 3)
+        #expect(queue.popFirst() == 3)
+    }
+
+    /// Порядок получения слотов и наибольшее число одновременно занятых
+    private actor Admissions {
+        private(set) var order: [String] = []
+        private(set) var peakInFlight = 0
+        private var inFlight = 0
+
+        func enter(_ name: String) {
+            order.append(name)
+            inFlight += 1
+            peakInFlight = max(peakInFlight, inFlight)
+        }
+
+        func leave() {
+            inFlight -= 1
+        }
+    }
+
+    private static func waitForQueue(_ slots: InferenceSlots, depth: Int) async {
+        while await slots.metrics().queueDepth < depth {
+            await Task.yield()
+        }
+    }
+
+    @Test("Один слот: очередь ждет, интерактивный запрос обгоняет пакетный")
+    func testSlotCap() async throws {
+        let slots = InferenceSlots(capacity: 1)
+        let admissions = Admissions()
+        try await slots.acquire(priority: .batch, cost: 0)
+        await admissions.enter("holder")
+
+        let requests: [(name: String, priority: SynthesisScheduler.Priority, cost: Int)] = [("batch", .batch, 10), ("interactive", .interactive, 500)]
+        let tasks = requests.map { request in
+            Task {
+                try await slots.acquire(priority: request.priority, cost: request.cost)
+                await admissions.enter(request.name)
+                await admissions.leave()
+                await slots.release()
+            }
+        }
+        await Self.waitForQueue(slots, depth: 2)
+        #expect(await slots.metrics().inFlight == 1)
+
+        await admissions.leave()
+        await slots.release()
+        for task in tasks {
+            try await task.value
+        }
+
+        #expect(await admissions.order == ["holder", "interactive", "batch"])
+        #expect(await admissions.peakInFlight == 1)
+        let metrics = await slots.metrics()
+        #expect(metrics.queueDepth == 0)
+        #expect(metrics.peakQueueDepth == 2)
+        #expect(metrics.inFlight == 0)
+        #expect(metrics.completed == 3)
+        #expect(metrics.cancelled == 0)
+        #expect(metrics.waits[.batch]?.requests == 2)
+        #expect(metrics.waits[.interactive]?.requests == 1)
+        #expect((metrics.waits[.batch]?.maxWait ?? 0) > 0)
+    }
+
+    @Test("Отмена ожидающей задачи снимает ее с очереди")
+    func testCancelledWaiter() async throws {
+        let slots = InferenceSlots(capacity: 1)
+        try await slots.acquire(priority: .interactive, cost: 0)
+
+        let waiter = Task {
+            try await slots.acquire(priority: .batch, cost: 0)
+        }
+        await Self.waitForQueue(slots, depth: 1)
+        waiter.cancel()
+        await #expect(throws: CancellationError.self) { try await waiter.value }
+
+        var metrics = await slots.metrics()
+        #expect(metrics.cancelled == 1)
+        #expect(metrics.queueDepth == 0)
+        #expect(metrics.peakQueueDepth == 1)
+        #expect(metrics.inFlight == 1)
+
+        // Освободившийся слот не достается отмененному запросу
+        await slots.release()
+        metrics = await slots.metrics()
+        #expect(metrics.inFlight == 0)
+        #expect(metrics.completed == 1)
+        #expect(metrics.waits[.batch] == nil)
+    }
+
+    @Test("Бенчмарк: выбор следующего запроса из очереди", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkQueue() {
+        var queue = SchedulingQueue<Int>()
+        var generator = SplitMix64(seed: 7)
+        let rate = Benchmark.throughput(iterations: 100_000) {
+            if queue.count < 64 {
+                queue.insert(0, priority: generator.next() % 4 == 0 ? .interactive : .batch, cost: Int(generator.next() % 510))
+            } else {
+                _ = queue.popFirst()
+            }
+        }
+        print("📊 Очередь глубиной 64: \(String(format: "%.0f", rate)) операций/с")
+    }
+}
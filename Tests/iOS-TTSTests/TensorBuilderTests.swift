@@ -0,0 +1,116 @@
+import Testing
+import Foundation
+import CoreML
+@testable import iOS_TTS
+
+/// Тесты сборки входных тензоров и чтения строк стилей из отображённого .npy
+struct TensorBuilderTests {
+
+    private static func floats(_ array: MLMultiArray) -> [Float] {
+        let pointer = array.dataPointer.bindMemory(to: Float.self, capacity: array.count)
+        return Array(UnsafeBufferPointer(start: pointer, count: array.count))
+    }
+
+    /// Пишет float32 .npy версии 1.0 с заголовком, выровненным до 64 байт
+    private static func writeNPY(_ values: [Float]) throws -> URL {
+        var header = "{'descr': '<f4', 'fortran_order': False, 'shape': (\(values.count),), }"
+        let padding = 64 - (10 + header.utf8.count + 1) % 64
+        header += String(repeating: " ", count: padding % 64) + "\n"
+
+        var data = Data([0x93, 0x4E, 0x55, 0x4D, 0x50, 0x59, 1, 0])
+        let length = UInt16(header.utf8.count)
+        data.append(contentsOf: [UInt8(length & 0xFF), UInt8(length >> 8)])
+        data.append(contentsOf: header.utf8)
+        values.withUnsafeBytes { data.append(contentsOf: $0) }
+
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("style-\(UUID().uuidString).npy")
+        try data.write(to: url)
+        return url
+    }
+
+    @Test("Маска: значение для реальных токенов, заполнитель для паддинга")
+    func testMask() throws {
+        let attention = try TensorBuilder.mask(length: 6, valid: 4, value: 1, fill: 0)
+        #expect(attention.shape == [1, 6])
+        #expect(Self.floats(attention) == [1, 1, 1, 1, 0, 0])
+
+        let text = try TensorBuilder.mask(length: 3, valid: 5, value: 0, fill: 1)
+        #expect(Self.floats(text) == [0, 0, 0])
+    }
+
+    @Test("Копирование и заполнение совпадают с поэлементной записью")
+    func testCopyAndFill() throws {
+        let values = (0..<128).map { Float($0) / 7 }
+        let copied = try values.withUnsafeBufferPointer { try TensorBuilder.array(copying: $0, shape: [1, 128]) }
+        #expect(copied.shape == [1, 128])
+        #expect(Self.floats(copied) == values)
+
+        let speed = try TensorBuilder.array(repeating: 1.25, shape: [1])
+        #expect(speed[0].floatValue == 1.25)
+
+        #expect(throws: TTSError.self) {
+            _ = try values.withUnsafeBufferPointer { try TensorBuilder.array(copying: $0, shape: [1, 256]) }
+        }
+    }
+
+    @Test("Отображённый .npy совпадает с прочитанным целиком")
+    func testMappedArray() throws {
+        let values = (0..<(4 * 8)).map { Float($0) - 0.5 }
+        let url = try Self.writeNPY(values)
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        #expect(try NPYParser.loadArray(from: url) == values)
+        let mapped = try NPYParser.mapArray(from: url)
+        #expect(mapped.count == values.count)
+        let row = mapped.withElements(in: 16..<24) { Array($0) }
+        #expect(row == Array(values[16..<24]))
+    }
+
+    @Test("Строка стиля выбирается по числу фонем")
+    func testStylePackRow() throws {
+        let values = (0..<(StylePack.rows * StylePack.width)).map { Float($0 / StylePack.width) }
+        let url = try Self.writeNPY(values)
+        defer { try? FileManager.default.removeItem(at: url) }
+        let pack = try StylePack(contentsOf: url)
+
+        #expect(pack.withStyleVector(forTokens: 0) { $0.count == 256 && $0.allSatisfy { $0 == 0 } })
+        #expect(pack.withStyleVector(forTokens: 12) { $0.allSatisfy { $0 == 11 } })
+        #expect(pack.withStyleVector(forTokens: 2000) { $0.allSatisfy { $0 == 509 } })
+
+        let short = try Self.writeNPY([1, 2, 3])
+        defer { try? FileManager.default.removeItem(at: short) }
+        #expect(throws: (any Error).self) { _ = try StylePack(contentsOf: short) }
+    }
+
+    @Test("Бенчмарк: поэлементная запись через NSNumber против TensorBuilder", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkBuilders() throws {
+        let length = 512
+        let style = (0..<128).map { Float($0) / 128 }
+        let iterations = 2000
+
+        func boxed() throws {
+            let mask = try MLMultiArray(shape: [1, NSNumber(value: length)], dataType: .float32)
+            for i in 0..<length {
+                mask[[0, i as NSNumber]] = NSNumber(value: i < 400 ? 1 : 0)
+            }
+            let styleArray = try MLMultiArray(shape: [1, 128], dataType: .float32)
+            for i in 0..<128 {
+                styleArray[[0, i as NSNumber]] = NSNumber(value: style[i])
+            }
+        }
+        func bulk() throws {
+            _ = try TensorBuilder.mask(length: length, valid: 400, value: 1, fill: 0)
+            _ = try style.withUnsafeBufferPointer { try TensorBuilder.array(copying: $0, shape: [1, 128]) }
+        }
+        try boxed()
+        try bulk()
+
+        let boxedSeconds = Benchmark.seconds {
+            for _ in 0..<iterations { try? boxed() }
+        }
+        let bulkSeconds = Benchmark.seconds {
+            for _ in 0..<iterations { try? bulk() }
+        }
+        print("📊 Маска \(length) + стиль 128, \(iterations) раз: NSNumber \(String(format: "%.2f", boxedSeconds * 1000)) мс, TensorBuilder \(String(format: "%.2f", bulkSeconds * 1000)) мс")
+    }
+}
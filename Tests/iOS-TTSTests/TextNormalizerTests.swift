@@ -0,0 +1,97 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты однопроходной предобработки текста
+struct TextNormalizerTests {
+
+    private static let corpus = [
+        "Hello world.",
+        "   leading and trailing \n\t ",
+        "Say [Kokoro](/kˈOkəɹO/) twice, [really](+2) [no](-0.5) and [x](#1#).",
+        "[a [b](c) nested [broken](no close",
+        "[](empty) [text]() tail[x](y)z",
+        "Tabs\tand\nnew\u{00A0}lines\u{2003}em space",
+        "Café costs €5, £3 or $2.50 — 100% sure…",
+        "[multi word link](0.5) then more",
+        ""
+    ]
+
+    @Test("Результат совпадает с regex-версией")
+    func testMatchesLegacy() {
+        for text in Self.corpus {
+            let expected = LegacyPreprocess.preprocess(text)
+            let actual = TextNormalizer.normalize(text)
+            #expect(actual.result == expected.result, "result: \(text)")
+            #expect(actual.tokens == expected.tokens, "tokens: \(text)")
+            #expect(actual.features.mapValues { "\($0)" } == expected.features.mapValues { "\($0)" }, "features: \(text)")
+        }
+    }
+
+    @Test("Бенчмарк: 1 МБ текста, regex-версия против байтового сканера", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkOneMegabyte() {
+        let paragraph = "The quick brown fox, aged 12, paid $3.50 for “café” snacks… Then it ran 5 km home. "
+        var text = ""
+        while text.utf8.count < 1 << 20 {
+            text += paragraph
+        }
+        // Ссылки делают regex-версию квадратичной из-за NSRange-конвертаций - меряем на меньшем тексте
+        let linked = String(repeating: "Read [Kokoro](/kˈOkəɹO/) and [this](+1) now. ", count: 500)
+
+        var legacyTokens = 0
+        let legacySeconds = Benchmark.seconds {
+            legacyTokens = LegacyPreprocess.preprocess(text).tokens.count
+            legacyTokens += LegacyPreprocess.preprocess(linked).tokens.count
+        }
+        var scannerTokens = 0
+        let scannerSeconds = Benchmark.seconds {
+            scannerTokens = TextNormalizer.normalize(text).tokens.count
+            scannerTokens += TextNormalizer.normalize(linked).tokens.count
+        }
+
+        print("📊 preprocess regex: \(String(format: "%.1f", Double(text.utf8.count) / legacySeconds / 1e6)) МБ/с")
+        print("📊 TextNormalizer:   \(String(format: "%.1f", Double(text.utf8.count) / scannerSeconds / 1e6)) МБ/с (x\(String(format: "%.1f", legacySeconds / scannerSeconds)))")
+    }
+}
+
+/// Прежняя regex-реализация preprocess - эталон для сравнения
+private enum LegacyPreprocess {
+    static func preprocess(_ text: String) -> (result: String, tokens: [String], features: [Int: Any]) {
+        var result = ""
+        var tokens: [String] = []
+        var features: [Int: Any] = [:]
+        var lastEnd = 0
+
+        let trimmedText = text.trimmingCharacters(in: .whitespacesAndNewlines)
+        let linkRegex = try! NSRegularExpression(pattern: #"\[([^\]]+)\]\(([^\)]*)\)"#)
+        let matches = linkRegex.matches(in: trimmedText, range: NSRange(trimmedText.startIndex..., in: trimmedText))
+
+        for match in matches {
+            let beforeRange = NSRange(location: lastEnd, length: match.range.location - lastEnd)
+            if let beforeSwiftRange = Range(beforeRange, in: trimmedText) {
+                let beforeText = String(trimmedText[beforeSwiftRange])
+                result += beforeText
+                tokens.append(contentsOf: beforeText.components(separatedBy: .whitespacesAndNewlines).filter { !$0.isEmpty })
+            }
+            if let textRange = Range(match.range(at: 1), in: trimmedText),
+               let featureRange = Range(match.range(at: 2), in: trimmedText) {
+                let linkText = String(trimmedText[textRange])
+                if let f = G2PEn.parseFeature(String(trimmedText[featureRange])) {
+                    features[tokens.count] = f
+                }
+                result += linkText
+                tokens.append(linkText)
+                lastEnd = match.range.location + match.range.length
+            }
+        }
+
+        // NSRange-смещения в UTF-16, поэтому длина - utf16.count
+        let length = trimmedText.utf16.count
+        if lastEnd < length, let remaining = Range(NSRange(location: lastEnd, length: length - lastEnd), in: trimmedText) {
+            let remainingText = String(trimmedText[remaining])
+            result += remainingText
+            tokens.append(contentsOf: remainingText.components(separatedBy: .whitespacesAndNewlines).filter { !$0.isEmpty })
+        }
+        return (result, tokens, features)
+    }
+}
@@ -0,0 +1,59 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты таблицы токенов и retokenize
+struct TokenTableTests {
+
+    @Test("retokenize раскладывает слова по индексам таблицы")
+    func testRetokenizeWords() {
+        let tokens = [
+            MToken(text: "Hello", tag: "UH", whitespace: " "),
+            MToken(text: "U.S.", tag: "NNP", whitespace: " "),
+            MToken(text: "$", tag: "$", whitespace: ""),
+            MToken(text: "5", tag: "CD", whitespace: "")
+        ]
+
+        let table = G2PEn.retokenize(tokens: tokens)
+
+        #expect(table.text == ["Hello", "U", ".", "S", ".", "$", "5"])
+        #expect(table.words == [.single(0), .group(1..<5), .single(5), .single(6)])
+        #expect(table.isHead[1...4] == [true, false, false, false])
+        #expect(table.whitespace[4] == " ")
+        #expect(table.phonemes[5] == "")
+        #expect(table.currency[6] == "$")
+    }
+
+    @Test("Токен из таблицы совпадает с исходным")
+    func testRoundTrip() {
+        var table = TokenTable()
+        let token = MToken(text: "read", tag: "VBD", whitespace: " ", phonemes: "ɹˈɛd", rating: 4,
+                           underscore: MToken.Underscore(isHead: false, stress: -1, currency: "$", numFlags: "a", rating: 3))
+        let index = table.append(token)
+
+        let copy = table[index]
+        #expect(copy.text == "read")
+        #expect(copy.phonemes == "ɹˈɛd")
+        #expect(copy.rating == 4)
+        #expect(copy.underscore.isHead == false)
+        #expect(copy.underscore.stress == -1)
+        #expect(copy.underscore.numFlags == "a")
+        #expect(table.indices(of: .group(2..<5)) == 2..<5)
+        #expect(table.indices(of: .single(index)) == 0..<1)
+    }
+
+    @Test("G2PResult из MToken внешних реализаций G2P")
+    func testResultFromTokens() {
+        let result = G2PResult(phonemeString: "bɔ̃ʒuʁ ❓", tokens: [
+            MToken(text: "Bonjour", tag: "UH", whitespace: " ", phonemes: "bɔ̃ʒuʁ", rating: 3),
+            MToken(text: "xyz", tag: "NN")
+        ])
+
+        #expect(result.tokens.map(\.text) == ["Bonjour", "xyz"])
+        #expect(result.tokens[0].phonemes == 0..<6)
+        #expect(result.tokens[0].rating == 3)
+        #expect(result.tokens[1].phonemes == 7..<7)
+        #expect(result.tokens[1].rating == nil)
+        #expect(G2PResult(phonemeString: "", tokens: []).tokens.isEmpty)
+    }
+}
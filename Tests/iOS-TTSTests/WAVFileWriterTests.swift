@@ -0,0 +1,102 @@
+import Testing
+import Foundation
+@testable import iOS_TTS
+
+/// Тесты потоковой записи WAV
+struct WAVFileWriterTests {
+
+    private static func temporaryURL() -> URL {
+        return FileManager.default.temporaryDirectory.appendingPathComponent("wav-\(UUID().uuidString).wav")
+    }
+
+    private static func read<T: FixedWidthInteger>(_ type: T.Type, _ data: Data, at offset: Int) -> T {
+        return data.subdata(in: offset..<(offset + MemoryLayout<T>.size)).withUnsafeBytes { T(littleEndian: $0.loadUnaligned(as: T.self)) }
+    }
+
+    @Test("PCM16: заголовок дописывается в конце, сэмплы обрезаются и округляются")
+    func testPCM16() throws {
+        let url = Self.temporaryURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        let writer = try WAVFileWriter(url: url)
+        for chunk: [Float] in [[0, 0.5, -0.5], [1.5, -2], [1]] {
+            try chunk.withUnsafeBufferPointer { try writer.write($0) }
+        }
+        try writer.finish()
+
+        let data = try Data(contentsOf: url)
+        #expect(data.count == 44 + 6 * 2)
+        #expect(String(decoding: data[0..<4], as: UTF8.self) == "RIFF")
+        #expect(Self.read(UInt32.self, data, at: 4) == UInt32(data.count - 8))
+        #expect(Self.read(UInt16.self, data, at: 20) == 1)
+        #expect(Self.read(UInt32.self, data, at: 24) == 24_000)
+        #expect(Self.read(UInt16.self, data, at: 34) == 16)
+        #expect(Self.read(UInt32.self, data, at: 40) == 12)
+
+        let samples = (0..<6).map { Self.read(Int16.self, data, at: 44 + $0 * 2) }
+        #expect(samples == [0, 16384, -16384, 32767, -32768, 32767])
+    }
+
+    @Test("Float32 с чанком fact")
+    func testFloat32() throws {
+        let url = Self.temporaryURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        try WAVFileWriter.write([0.25, -1.5], to: url, sampleRate: 48_000, format: .float32)
+
+        let data = try Data(contentsOf: url)
+        #expect(data.count == 58 + 2 * 4)
+        #expect(Self.read(UInt16.self, data, at: 20) == 3)
+        #expect(Self.read(UInt32.self, data, at: 24) == 48_000)
+        #expect(String(decoding: data[38..<42], as: UTF8.self) == "fact")
+        #expect(Self.read(UInt32.self, data, at: 46) == 2)
+        #expect(Self.read(UInt32.self, data, at: 54) == 8)
+        let samples = (0..<2).map { Float(bitPattern: Self.read(UInt32.self, data, at: 58 + $0 * 4)) }
+        #expect(samples == [0.25, -1])
+    }
+
+    @Test("Дизеринг отклоняется не больше чем на 1 LSB")
+    func testDither() throws {
+        let input = (0..<10_000).map { Float(sin(Double($0) * 0.01)) * 0.3 }
+        let plainURL = Self.temporaryURL()
+        let ditheredURL = Self.temporaryURL()
+        defer {
+            try? FileManager.default.removeItem(at: plainURL)
+            try? FileManager.default.removeItem(at: ditheredURL)
+        }
+
+        try WAVFileWriter.write(input, to: plainURL)
+        try WAVFileWriter.write(input, to: ditheredURL, dither: true)
+
+        let plain = try Data(contentsOf: plainURL)
+        let dithered = try Data(contentsOf: ditheredURL)
+        var changed = 0
+        for i in 0..<input.count {
+            let a = Int(Self.read(Int16.self, plain, at: 44 + i * 2))
+            let b = Int(Self.read(Int16.self, dithered, at: 44 + i * 2))
+            #expect(abs(a - b) <= 1)
+            changed += a == b ? 0 : 1
+        }
+        #expect(changed > 0)
+    }
+
+    @Test("Бенчмарк: скалярная конвертация против Accelerate", .tags(.benchmark), .enabled(if: Benchmark.isEnabled))
+    func benchmarkConversion() throws {
+        let input = (0..<(24_000 * 60)).map { Float(sin(Double($0) * 0.01)) * 1.2 }
+        let url = Self.temporaryURL()
+        defer { try? FileManager.default.removeItem(at: url) }
+
+        var scalar = [Int16](repeating: 0, count: input.count)
+        let scalarSeconds = Benchmark.seconds {
+            for i in 0..<input.count {
+                scalar[i] = Int16((max(-1, min(1, input[i])) * 32767).rounded())
+            }
+        }
+        let writerSeconds = Benchmark.seconds {
+            try? WAVFileWriter.write(input, to: url)
+        }
+
+        print("📊 PCM16 скаляр: \(String(format: "%.1f", Double(input.count) / scalarSeconds / 1e6)) Мсэмплов/с (без записи на диск)")
+        print("📊 WAVFileWriter: \(String(format: "%.1f", Double(input.count) / writerSeconds / 1e6)) Мсэмплов/с (с записью на диск)")
+    }
+}